@@ -0,0 +1,12 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or dt.hpp
+
+#ifdef DMITIGR_DT_NOMINMAX
+#undef DMITIGR_DT_NOMINMAX
+#undef NOMINMAX
+#endif
+
+#ifdef DMITIGR_DT_INLINE
+#undef DMITIGR_DT_INLINE
+#endif
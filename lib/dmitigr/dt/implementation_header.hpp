@@ -0,0 +1,20 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or dt.hpp
+
+#ifndef DMITIGR_DT_INLINE
+  #if defined(DMITIGR_DT_HEADER_ONLY) && !defined(DMITIGR_DT_BUILDING)
+    #define DMITIGR_DT_INLINE inline
+  #else
+    #define DMITIGR_DT_INLINE
+  #endif
+#endif  // DMITIGR_DT_INLINE
+
+#ifndef DMITIGR_DT_NOMINMAX
+  #ifdef _WIN32
+    #ifndef NOMINMAX
+      #define NOMINMAX
+      #define DMITIGR_DT_NOMINMAX
+    #endif
+  #endif
+#endif  // DMITIGR_DT_NOMINMAX
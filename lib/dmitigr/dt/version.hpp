@@ -0,0 +1,31 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or dt.hpp
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// This file was generated automatically. Edit version.hpp.in instead!!!!!!!!!!!
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+#ifndef DMITIGR_DT_VERSION_HPP
+#define DMITIGR_DT_VERSION_HPP
+
+#include <cstdint>
+
+namespace dmitigr::dt {
+
+/**
+ * @returns The library version.
+ */
+constexpr inline std::int_fast32_t version()
+{
+  // Actual values are set in CMakeLists.txt.
+  constexpr std::int_least32_t major = 0;
+  constexpr std::int_least32_t minor = 1;
+
+  // 11.234 -> 11 * 1000 + 234 = 11234
+  return major*1000 + minor;
+}
+
+} // namespace dmitigr::dt
+
+#endif  // DMITIGR_DT_VERSION_HPP
@@ -0,0 +1,12 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or http.hpp
+
+#ifdef DMITIGR_HTTP_NOMINMAX
+#undef DMITIGR_HTTP_NOMINMAX
+#undef NOMINMAX
+#endif
+
+#ifdef DMITIGR_HTTP_INLINE
+#undef DMITIGR_HTTP_INLINE
+#endif
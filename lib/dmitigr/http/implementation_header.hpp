@@ -0,0 +1,20 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or http.hpp
+
+#ifndef DMITIGR_HTTP_INLINE
+  #if defined(DMITIGR_HTTP_HEADER_ONLY) && !defined(DMITIGR_HTTP_BUILDING)
+    #define DMITIGR_HTTP_INLINE inline
+  #else
+    #define DMITIGR_HTTP_INLINE
+  #endif
+#endif  // DMITIGR_HTTP_INLINE
+
+#ifndef DMITIGR_HTTP_NOMINMAX
+  #ifdef _WIN32
+    #ifndef NOMINMAX
+      #define NOMINMAX
+      #define DMITIGR_HTTP_NOMINMAX
+    #endif
+  #endif
+#endif  // DMITIGR_HTTP_NOMINMAX
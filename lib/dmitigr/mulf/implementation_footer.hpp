@@ -0,0 +1,12 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or mulf.hpp
+
+#ifdef DMITIGR_MULF_NOMINMAX
+#undef DMITIGR_MULF_NOMINMAX
+#undef NOMINMAX
+#endif
+
+#ifdef DMITIGR_MULF_INLINE
+#undef DMITIGR_MULF_INLINE
+#endif
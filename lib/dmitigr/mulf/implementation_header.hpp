@@ -0,0 +1,20 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or mulf.hpp
+
+#ifndef DMITIGR_MULF_INLINE
+  #if defined(DMITIGR_MULF_HEADER_ONLY) && !defined(DMITIGR_MULF_BUILDING)
+    #define DMITIGR_MULF_INLINE inline
+  #else
+    #define DMITIGR_MULF_INLINE
+  #endif
+#endif  // DMITIGR_MULF_INLINE
+
+#ifndef DMITIGR_MULF_NOMINMAX
+  #ifdef _WIN32
+    #ifndef NOMINMAX
+      #define NOMINMAX
+      #define DMITIGR_MULF_NOMINMAX
+    #endif
+  #endif
+#endif  // DMITIGR_MULF_NOMINMAX
@@ -31,21 +31,30 @@
 #include "dmitigr/pgfe/compositional.hpp"
 #include "dmitigr/pgfe/connection.hpp"
 #include "dmitigr/pgfe/connection_options.hpp"
+#include "dmitigr/pgfe/connection_pool.hpp"
 #include "dmitigr/pgfe/conversions_api.hpp"
 #include "dmitigr/pgfe/conversions.hpp"
+#include "dmitigr/pgfe/copier.hpp"
+#include "dmitigr/pgfe/cursor.hpp"
 #include "dmitigr/pgfe/data.hpp"
 #include "dmitigr/pgfe/errc.hpp"
 #include "dmitigr/pgfe/error.hpp"
 #include "dmitigr/pgfe/exceptions.hpp"
+#include "dmitigr/pgfe/instrumentation.hpp"
 #include "dmitigr/pgfe/message.hpp"
 #include "dmitigr/pgfe/misc.hpp"
 #include "dmitigr/pgfe/notice.hpp"
 #include "dmitigr/pgfe/notification.hpp"
+#include "dmitigr/pgfe/notification_dispatcher.hpp"
 #include "dmitigr/pgfe/parameterizable.hpp"
 #include "dmitigr/pgfe/problem.hpp"
+#include "dmitigr/pgfe/reactor.hpp"
+#include "dmitigr/pgfe/record.hpp"
 #include "dmitigr/pgfe/response.hpp"
 #include "dmitigr/pgfe/row.hpp"
 #include "dmitigr/pgfe/row_info.hpp"
+#include "dmitigr/pgfe/row_mapper.hpp"
+#include "dmitigr/pgfe/row_set.hpp"
 #include "dmitigr/pgfe/server_message.hpp"
 #include "dmitigr/pgfe/signal.hpp"
 #include "dmitigr/pgfe/sql_string.hpp"
@@ -14,10 +14,15 @@
 #include <dmitigr/util/string.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <locale>
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace dmitigr::pgfe {
@@ -40,6 +45,23 @@ std::string to_array_literal(const Container<Optional<T>, Allocator<Optional<T>>
 template<class Container, typename ... Types>
 Container to_container(const char* literal, char delimiter = ',', Types&& ... args);
 
+/**
+ * @returns The PostgreSQL binary array representation of the `container`.
+ */
+template<class Container>
+std::string to_array_binary(const Container& container);
+
+/**
+ * @returns The container representation of the PostgreSQL binary array
+ * of the specified `size`.
+ *
+ * @throws Client_exception with code of Client_errc::improper_value_type_of_container
+ * if the type of the array elements cannot be decoded to the type of the
+ * elements of the container.
+ */
+template<class Container>
+Container to_container_from_binary(const char* bytes, std::size_t size);
+
 // =============================================================================
 
 /**
@@ -205,8 +227,11 @@ struct Array_data_conversions_opts<Container<Optional<T>, Allocator<Optional<T>>
   template<typename ... Types>
   static Type to_type(const Data* const data, Types&& ... args)
   {
-    DMITIGR_REQUIRE(data && data->format() == Data_format::text, std::invalid_argument);
-    return to_container<Type>(data->bytes(), ',', std::forward<Types>(args)...);
+    DMITIGR_REQUIRE(data, std::invalid_argument);
+    if (data->format() == Data_format::binary)
+      return to_container_from_binary<Type>(data->bytes(), data->size());
+    else
+      return to_container<Type>(data->bytes(), ',', std::forward<Types>(args)...);
   }
 
   template<typename ... Types>
@@ -221,6 +246,14 @@ struct Array_data_conversions_opts<Container<Optional<T>, Allocator<Optional<T>>
     using StringConversions = Array_string_conversions_opts<Type>;
     return Data::make(StringConversions::to_string(value, std::forward<Types>(args)...));
   }
+
+  static std::unique_ptr<Data> to_data(const Type& value, const Data_format format)
+  {
+    if (format == Data_format::binary)
+      return Data::make(to_array_binary(value), Data_format::binary);
+    else
+      return to_data(value);
+  }
 };
 
 // =============================================================================
@@ -791,6 +824,442 @@ auto to_container_of_optionals(Container<T, Allocator<T>>&& container)
   return result;
 }
 
+// -----------------------------------------------------------------------------
+// Binary format
+// -----------------------------------------------------------------------------
+
+/*
+ * The PostgreSQL binary array representation (see array_send() and
+ * array_recv() in src/backend/utils/adt/arrayfuncs.c) is as follows:
+ *   - int32 ndim - the number of dimensions;
+ *   - int32 flags - `1` if the array has NULL elements, or `0` otherwise;
+ *   - uint32 element type OID;
+ *   - ndim pairs of int32 (the size of the dimension, the lower bound);
+ *   - the elements in row-major order, each of which is represented as int32
+ *     length (`-1` denotes NULL) followed by the bytes of the element.
+ * All the integers are in network byte order (big-endian).
+ */
+
+namespace arrays {
+
+/**
+ * @brief Appends the `value` to the `result` in network byte order.
+ */
+template<typename U>
+inline void append_big_endian(std::string& result, const U value)
+{
+  static_assert(std::is_unsigned_v<U>);
+  for (auto i = static_cast<int>(sizeof(U)) - 1; i >= 0; --i)
+    result.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+}
+
+/**
+ * @returns The unsigned integer of type `U` read from `pos` in network byte
+ * order. The `pos` is advanced by `sizeof(U)` bytes.
+ *
+ * @throws Client_exception with code of Client_errc::malformed_binary_array
+ * if there are less than `sizeof(U)` bytes in the range [pos, end).
+ */
+template<typename U>
+inline U read_big_endian(const char*& pos, const char* const end)
+{
+  static_assert(std::is_unsigned_v<U>);
+  if (end - pos < static_cast<std::ptrdiff_t>(sizeof(U)))
+    throw iClient_exception{Client_errc::malformed_binary_array};
+
+  U result{};
+  for (std::size_t i = 0; i < sizeof(U); ++i)
+    result = static_cast<U>((result << 8) | static_cast<unsigned char>(*pos++));
+  return result;
+}
+
+/**
+ * @returns The signed 32-bit integer read from `pos`.
+ */
+inline std::int32_t read_int32(const char*& pos, const char* const end)
+{
+  return static_cast<std::int32_t>(read_big_endian<std::uint32_t>(pos, end));
+}
+
+/**
+ * @brief Appends the signed 32-bit integer to the `result`.
+ */
+inline void append_int32(std::string& result, const std::int32_t value)
+{
+  append_big_endian(result, static_cast<std::uint32_t>(value));
+}
+
+/**
+ * @brief Elements of binary arrays conversions.
+ *
+ * This is a generic implementation which decodes the elements by using the
+ * suitable specialization of Conversions. The encoding is not supported.
+ */
+template<typename T, typename = void>
+struct Binary_element_conversions final {
+  static constexpr bool is_encodable = false;
+
+  /**
+   * @returns `true` since the element type OID corresponding to `T` is unknown.
+   */
+  static constexpr bool is_compatible_oid(std::uint32_t) noexcept
+  {
+    return true;
+  }
+
+  static T to_type(const char* const bytes, const std::size_t size)
+  {
+    return Conversions<T>::to_type(Data::make(bytes, size, Data_format::binary));
+  }
+};
+
+/**
+ * @brief The partial specialization of Binary_element_conversions for the
+ * types which are mapped to `smallint`, `integer` and `bigint`.
+ */
+template<typename T>
+struct Binary_element_conversions<T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T> &&
+    !std::is_same_v<T, char> && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>> final {
+  static constexpr bool is_encodable = true;
+  static constexpr std::uint32_t oid = (sizeof(T) == 2) ? 21 : (sizeof(T) == 4) ? 23 : 20;
+
+  /**
+   * @returns `true` if the elements of type `oid` can be decoded to `T`
+   * (the narrower integers are accepted).
+   */
+  static constexpr bool is_compatible_oid(const std::uint32_t oid) noexcept
+  {
+    return oid == 21 || (sizeof(T) >= 4 && oid == 23) || (sizeof(T) == 8 && oid == 20);
+  }
+
+  static T to_type(const char* bytes, const std::size_t size)
+  {
+    if (size == 0 || size > sizeof(T))
+      throw iClient_exception{Client_errc::malformed_binary_array};
+
+    // The value is sign-extended in order to accept the narrower integers.
+    std::uint64_t result = (static_cast<unsigned char>(*bytes) & 0x80) ? ~std::uint64_t{} : 0;
+    for (const char* const end = bytes + size; bytes != end; ++bytes)
+      result = (result << 8) | static_cast<unsigned char>(*bytes);
+    return static_cast<T>(static_cast<std::int64_t>(result));
+  }
+
+  static void append(std::string& result, const T value)
+  {
+    using U = std::make_unsigned_t<T>;
+    append_int32(result, sizeof(T));
+    append_big_endian(result, static_cast<U>(value));
+  }
+};
+
+/**
+ * @brief The partial specialization of Binary_element_conversions for the
+ * types which are mapped to `real` and `double precision`.
+ */
+template<typename T>
+struct Binary_element_conversions<T, std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>>> final {
+  static_assert(std::numeric_limits<float>::is_iec559 && sizeof(float) == 4);
+  static_assert(std::numeric_limits<double>::is_iec559 && sizeof(double) == 8);
+
+  static constexpr bool is_encodable = true;
+  static constexpr std::uint32_t oid = std::is_same_v<T, float> ? 700 : 701;
+
+  /**
+   * @returns `true` if the elements of type `oid` can be decoded to `T`
+   * (the `real` is accepted for `double`).
+   */
+  static constexpr bool is_compatible_oid(const std::uint32_t oid) noexcept
+  {
+    return oid == 700 || (std::is_same_v<T, double> && oid == 701);
+  }
+
+  static T to_type(const char* bytes, const std::size_t size)
+  {
+    const char* const end = bytes + size;
+    if (size == sizeof(float))
+      return static_cast<T>(from_bits<float>(read_big_endian<std::uint32_t>(bytes, end)));
+    else if (size == sizeof(double))
+      return static_cast<T>(from_bits<double>(read_big_endian<std::uint64_t>(bytes, end)));
+    else
+      throw iClient_exception{Client_errc::malformed_binary_array};
+  }
+
+  static void append(std::string& result, const T value)
+  {
+    using U = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    U bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    append_int32(result, sizeof(T));
+    append_big_endian(result, bits);
+  }
+
+private:
+  template<typename F, typename U>
+  static F from_bits(const U bits)
+  {
+    static_assert(sizeof(F) == sizeof(U));
+    F result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+  }
+};
+
+/**
+ * @brief The full specialization of Binary_element_conversions for the
+ * type which is mapped to `boolean`.
+ */
+template<>
+struct Binary_element_conversions<bool> final {
+  static constexpr bool is_encodable = true;
+  static constexpr std::uint32_t oid = 16;
+
+  /**
+   * @returns `true` if `oid` is the OID of `boolean`.
+   */
+  static constexpr bool is_compatible_oid(const std::uint32_t oid) noexcept
+  {
+    return oid == Binary_element_conversions::oid;
+  }
+
+  static bool to_type(const char* const bytes, const std::size_t size)
+  {
+    if (size != 1)
+      throw iClient_exception{Client_errc::malformed_binary_array};
+    return *bytes != 0;
+  }
+
+  static void append(std::string& result, const bool value)
+  {
+    append_int32(result, 1);
+    result.push_back(value ? 1 : 0);
+  }
+};
+
+/**
+ * @brief The full specialization of Binary_element_conversions for the
+ * type which is mapped to `text`.
+ */
+template<>
+struct Binary_element_conversions<std::string> final {
+  static constexpr bool is_encodable = true;
+  static constexpr std::uint32_t oid = 25;
+
+  /**
+   * @returns `true` if `oid` is the OID of `text`, `character varying`,
+   * `character` or `name`, which binary representation is the same.
+   */
+  static constexpr bool is_compatible_oid(const std::uint32_t oid) noexcept
+  {
+    return oid == 25 || oid == 1043 || oid == 1042 || oid == 19;
+  }
+
+  static std::string to_type(const char* const bytes, const std::size_t size)
+  {
+    return std::string(bytes, size);
+  }
+
+  static void append(std::string& result, const std::string& value)
+  {
+    DMITIGR_REQUIRE(value.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()),
+      std::invalid_argument);
+    append_int32(result, static_cast<std::int32_t>(value.size()));
+    result.append(value);
+  }
+};
+
+/**
+ * @brief The dimensionality of the container of optionals.
+ */
+template<typename T>
+struct Dimensionality final : std::integral_constant<int, 0> {};
+
+/**
+ * @brief The partial specialization of the structure template Dimensionality.
+ */
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator>
+struct Dimensionality<Container<Optional<T>, Allocator<Optional<T>>>> final
+  : std::integral_constant<int, 1 + Dimensionality<T>::value> {};
+
+/**
+ * @brief The type of the elements of the deepest container.
+ */
+template<typename T>
+struct Deepest_element final {
+  using Type = T;
+};
+
+/**
+ * @brief The partial specialization of the structure template Deepest_element.
+ */
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator>
+struct Deepest_element<Container<Optional<T>, Allocator<Optional<T>>>> final {
+  using Type = typename Deepest_element<T>::Type;
+};
+
+/**
+ * @brief Stores the sizes of the dimensions of the `container` into `dims`.
+ *
+ * @par Requires
+ * The subcontainers must not be NULLs.
+ */
+template<class Container>
+void fill_binary_array_dimensions(const Container& container, std::int32_t* const dims)
+{
+  DMITIGR_REQUIRE(container.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()),
+    std::invalid_argument);
+  *dims = static_cast<std::int32_t>(container.size());
+  if constexpr (Dimensionality<Container>::value > 1) {
+    if (!container.empty()) {
+      const auto& first = *cbegin(container);
+      DMITIGR_REQUIRE(first, std::invalid_argument, "NULL subarray");
+      fill_binary_array_dimensions(*first, dims + 1);
+    }
+  }
+}
+
+/**
+ * @brief Appends the elements of the `container` to the `result`.
+ *
+ * @returns `true` if at least one of the elements is NULL.
+ *
+ * @par Requires
+ * The `container` must be rectangular (the sizes of the subcontainers of the
+ * same dimension must be equal).
+ */
+template<class Container>
+bool append_binary_array_elements(std::string& result, const Container& container, const std::int32_t* const dims)
+{
+  DMITIGR_REQUIRE(container.size() == static_cast<std::size_t>(*dims), std::invalid_argument,
+    "non-rectangular array");
+  bool has_null{};
+  for (const auto& elem : container) {
+    if constexpr (Dimensionality<Container>::value > 1) {
+      DMITIGR_REQUIRE(elem, std::invalid_argument, "NULL subarray");
+      has_null |= append_binary_array_elements(result, *elem, dims + 1);
+    } else if (elem) {
+      using Element = typename Deepest_element<Container>::Type;
+      Binary_element_conversions<Element>::append(result, *elem);
+    } else {
+      append_int32(result, -1);
+      has_null = true;
+    }
+  }
+  return has_null;
+}
+
+/**
+ * @brief Fills the container with the elements of the binary array.
+ */
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator>
+void fill_container_from_binary(Container<Optional<T>, Allocator<Optional<T>>>& result,
+  const std::int32_t* const dims, const char*& pos, const char* const end)
+{
+  for (std::int32_t i = 0; i < *dims; ++i) {
+    if constexpr (Dimensionality<T>::value > 0) {
+      result.push_back(T());
+      Optional<T>& elem = result.back();
+      fill_container_from_binary(*elem, dims + 1, pos, end);
+    } else {
+      const auto length = read_int32(pos, end);
+      if (length == -1)
+        result.push_back(Optional<T>());
+      else if (length < 0 || end - pos < length)
+        throw iClient_exception{Client_errc::malformed_binary_array};
+      else {
+        result.push_back(Binary_element_conversions<T>::to_type(pos, static_cast<std::size_t>(length)));
+        pos += length;
+      }
+    }
+  }
+}
+
+} // namespace arrays
+
+template<class Container>
+std::string to_array_binary(const Container& container)
+{
+  using namespace arrays;
+  using Element_conversions = Binary_element_conversions<typename Deepest_element<Container>::Type>;
+  static_assert(Element_conversions::is_encodable,
+    "binary encoding of arrays of such elements is not implemented");
+
+  constexpr int ndim = Dimensionality<Container>::value;
+  std::int32_t dims[ndim]{};
+  fill_binary_array_dimensions(container, dims);
+  const bool is_empty = std::any_of(dims, dims + ndim, [](const auto d) { return d == 0; });
+
+  std::string result;
+  append_int32(result, is_empty ? 0 : ndim);
+  append_int32(result, 0); // has null (to be patched below)
+  append_big_endian(result, Element_conversions::oid);
+  if (!is_empty) {
+    for (const auto d : dims) {
+      append_int32(result, d);
+      append_int32(result, 1); // lower bound
+    }
+    if (append_binary_array_elements(result, container, dims))
+      result[7] = 1;
+  }
+
+  return result;
+}
+
+template<class Container>
+Container to_container_from_binary(const char* const bytes, const std::size_t size)
+{
+  DMITIGR_ASSERT(bytes);
+  using namespace arrays;
+
+  const char* pos = bytes;
+  const char* const end = bytes + size;
+
+  const auto ndim = read_int32(pos, end);
+  const auto flags = read_int32(pos, end);
+  const auto element_oid = read_big_endian<std::uint32_t>(pos, end);
+  if (flags & ~1)
+    throw iClient_exception{Client_errc::malformed_binary_array};
+  else if (!Binary_element_conversions<typename Deepest_element<Container>::Type>::is_compatible_oid(element_oid))
+    throw iClient_exception{Client_errc::improper_value_type_of_container};
+
+  Container result;
+  if (ndim == 0)
+    return result;
+
+  constexpr int cont_ndim = Dimensionality<Container>::value;
+  if (ndim < 0)
+    throw iClient_exception{Client_errc::malformed_binary_array};
+  else if (ndim < cont_ndim)
+    throw iClient_exception{Client_errc::excessive_array_dimensionality};
+  else if (ndim > cont_ndim)
+    throw iClient_exception{Client_errc::insufficient_array_dimensionality};
+
+  std::int32_t dims[cont_ndim]{};
+  for (auto& d : dims) {
+    d = read_int32(pos, end);
+    read_int32(pos, end); // lower bound
+    if (d < 0)
+      throw iClient_exception{Client_errc::malformed_binary_array};
+  }
+  // The zero inner dimension is only possible with the zero outer one.
+  if (dims[0] != 0 && std::find(dims + 1, dims + cont_ndim, 0) != dims + cont_ndim)
+    throw iClient_exception{Client_errc::malformed_binary_array};
+
+  fill_container_from_binary(result, dims, pos, end);
+  if (pos != end)
+    throw iClient_exception{Client_errc::malformed_binary_array};
+
+  return result;
+}
+
 } // namespace detail
 
 /**
@@ -819,8 +1288,16 @@ auto to_container_of_optionals(Container<T, Allocator<T>>&& container)
  * @tparam Allocator - the allocator template class, such as `std::allocator`.
  *
  * The support of the following data formats is implemented:
- *   - for input data  - Data_format::text;
- *   - for output data - Data_format::text.
+ *   - for input data  - Data_format::text, Data_format::binary;
+ *   - for output data - Data_format::text, Data_format::binary.
+ *
+ * The output data is in the binary format if Data_format::binary is passed as
+ * the second argument of `to_data()`. The binary encoding is implemented for
+ * the arrays of `short`, `int`, `long`, `long long` (mapped to `smallint`,
+ * `integer` or `bigint` depending on the size), `float`, `double`, `bool` and
+ * `std::string` (mapped to `text`). The elements of the binary input data of
+ * the other types are converted by using the suitable specializations of
+ * Conversions for Data_format::binary.
  */
 template<typename T,
   template<class> class Optional,
@@ -851,8 +1328,16 @@ struct Conversions<Container<Optional<T>, Allocator<Optional<T>>>> final
  * when converting the PostgreSQL array representations with at least one `NULL` element.
  *
  * The support of the following data formats is implemented:
- *   - for input data  - Data_format::text;
- *   - for output data - Data_format::text.
+ *   - for input data  - Data_format::text, Data_format::binary;
+ *   - for output data - Data_format::text, Data_format::binary.
+ *
+ * The output data is in the binary format if Data_format::binary is passed as
+ * the second argument of `to_data()`. The binary encoding is implemented for
+ * the arrays of `short`, `int`, `long`, `long long` (mapped to `smallint`,
+ * `integer` or `bigint` depending on the size), `float`, `double`, `bool` and
+ * `std::string` (mapped to `text`). The elements of the binary input data of
+ * the other types are converted by using the suitable specializations of
+ * Conversions for Data_format::binary.
  */
 template<typename T,
   template<class, class> class Container,
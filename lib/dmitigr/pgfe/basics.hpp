@@ -168,6 +168,43 @@ enum class Data_format {
 
 // =============================================================================
 
+/**
+ * @ingroup main
+ *
+ * @brief A mode of delivering the rows produced by a PostgreSQL server.
+ */
+enum class Row_processing {
+  /**
+   * Each row is delivered as the separate Row just after it arrives. This
+   * mode is suitable for the huge or unbounded results.
+   */
+  single = 0,
+
+  /**
+   * All of the rows of the result are delivered at once as the Row_set. This
+   * mode avoids the per-row overhead but requires the whole result to be
+   * retained in memory.
+   */
+  batch = 100
+};
+
+// =============================================================================
+
+/**
+ * @ingroup main
+ *
+ * @brief A direction of data transfer.
+ */
+enum class Data_direction {
+  /** From the client to the server (`COPY ... FROM STDIN`). */
+  to_server = 0,
+
+  /** From the server to the client (`COPY ... TO STDOUT`). */
+  from_server = 100
+};
+
+// =============================================================================
+
 /**
  * @ingroup main
  *
@@ -4,8 +4,10 @@
 
 #include "dmitigr/pgfe/basics.hpp"
 #include "dmitigr/pgfe/completion.hpp"
+#include "dmitigr/pgfe/composite.hpp"
 #include "dmitigr/pgfe/connection.hpp"
 #include "dmitigr/pgfe/connection_options.hpp"
+#include "dmitigr/pgfe/copier_impl.hpp"
 #include "dmitigr/pgfe/data.hpp"
 #include "dmitigr/pgfe/error.hpp"
 #include "dmitigr/pgfe/exceptions.hpp"
@@ -15,16 +17,21 @@
 #include "dmitigr/pgfe/prepared_statement_impl.hpp"
 #include "dmitigr/pgfe/row.hpp"
 #include "dmitigr/pgfe/row_info.hpp"
+#include "dmitigr/pgfe/row_set.hpp"
 #include "dmitigr/pgfe/sql_string.hpp"
+#include "dmitigr/pgfe/sql_vector.hpp"
 #include "dmitigr/pgfe/util.hpp"
 #include "dmitigr/pgfe/implementation_header.hpp"
 
 #include <dmitigr/util/debug.hpp>
 
+#include <algorithm>
 #include <list>
 #include <optional>
 #include <queue>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -119,6 +126,16 @@ public:
       current_status = communication_status();
     } // while
 
+    // Stage 3: preparing the statements of the manifest.
+    if (statement_manifest_) {
+      try {
+        prepare_statement_manifest(ignore_timeout ? milliseconds{-1} : timeout);
+      } catch (...) {
+        disconnect();
+        throw;
+      }
+    }
+
     DMITIGR_ASSERT(is_invariant_ok());
   }
 
@@ -167,6 +184,8 @@ public:
   }
 
 protected:
+  friend iReactor;
+
   virtual int socket() const = 0;
 
 public:
@@ -192,12 +211,15 @@ public:
     while (true) {
       collect_server_messages();
       handle_signals();
-      if (is_response_available())
+      if (is_response_available() || !is_awaiting_response())
         break;
       const auto timepoint1 = system_clock::now();
-      if (wait_socket_readiness(Socket_readiness::read_ready, timeout) == Socket_readiness::read_ready) {
+      const auto readiness = wait_socket_readiness(Socket_readiness::read_ready, timeout);
+      const auto waited = system_clock::now() - timepoint1;
+      statistics_.wait_time += std::chrono::duration_cast<std::chrono::nanoseconds>(waited);
+      if (readiness == Socket_readiness::read_ready) {
         if (!ignore_timeout)
-          timeout -= duration_cast<milliseconds>(system_clock::now() - timepoint1);
+          timeout -= duration_cast<milliseconds>(waited);
       } else
         // Timeout.
         break;
@@ -280,16 +302,128 @@ public:
     wait_response_throw(); // Checking invariant.
   }
 
-protected:
-  virtual bool is_invariant_ok() = 0;
+  void set_statement_manifest(std::shared_ptr<const Statement_manifest> manifest) override
+  {
+    statement_manifest_ = std::move(manifest);
+    if (statement_manifest_ && is_connected())
+      prepare_statement_manifest();
+  }
 
-  virtual std::string error_message() const = 0;
+  std::shared_ptr<const Statement_manifest> statement_manifest() const noexcept override
+  {
+    return statement_manifest_;
+  }
+
+  void prepare_statement_manifest(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) override
+  {
+    using std::chrono::milliseconds;
+    using std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+
+    DMITIGR_REQUIRE(timeout >= milliseconds{-1}, std::invalid_argument);
+    DMITIGR_REQUIRE(is_ready_for_request(), std::logic_error);
+
+    if (!statement_manifest_)
+      return;
+
+    // The manifest is kept alive even if it's reset by a handler upon waiting.
+    const auto manifest = statement_manifest_;
+
+    const bool ignore_timeout = (timeout == milliseconds{-1});
+    const auto deadline = steady_clock::now() + (ignore_timeout ? milliseconds{} : timeout);
+    bool is_timed_out{};
+
+    // Waits for the next response within the rest of the timeout.
+    const auto wait = [&]
+    {
+      if (ignore_timeout)
+        return wait_response();
+
+      const auto remaining = std::max(milliseconds{},
+        duration_cast<milliseconds>(deadline - steady_clock::now()));
+      wait_response(remaining);
+      if (!is_response_available()) {
+        is_timed_out = true;
+        throw iClient_exception{Client_errc::timed_out, "statement manifest preparation timeout"};
+      }
+    };
+
+    const bool is_pipeline_was_enabled = is_pipeline_enabled();
+    if (!is_pipeline_was_enabled)
+      set_pipeline_enabled(true);
+
+    // Collects the responses to the submitted requests and restores the pipeline mode.
+    const auto finish = [this, is_pipeline_was_enabled]
+    {
+      if (is_awaiting_response())
+        wait_last_response();
+      dismiss_response();
+      if (!is_pipeline_was_enabled)
+        set_pipeline_enabled(false);
+    };
 
-  void throw_if_error()
+    std::size_t request_count{};
+    try {
+      for (const auto& [name, statement] : *manifest) {
+        if (prepared_statement(name)) {
+          unprepare_statement_async(name);
+          ++request_count;
+        }
+        prepare_statement_async(statement.get(), name);
+        ++request_count;
+      }
+    } catch (...) {
+      synchronize_pipeline_async();
+      finish();
+      throw;
+    }
+    synchronize_pipeline_async();
+
+    std::shared_ptr<Error> error;
+    try {
+      for (std::size_t i = 0; i < request_count; ++i) {
+        wait();
+        if (auto e = release_error()) {
+          if (!error)
+            error = std::move(e);
+        } else
+          dismiss_response(); // the Prepared_statement or the Completion
+      }
+      wait(); // the Completion of the synchronization point
+      finish();
+    } catch (...) {
+      if (!is_timed_out)
+        finish();
+      throw;
+    }
+
+    if (error)
+      throw iServer_exception(std::move(error));
+  }
+
+  void throw_if_error() override
   {
     if (const std::shared_ptr<Error> ei{release_error()}; ei)
       throw iServer_exception(ei);
   }
+
+  const Connection_statistics& statistics() const noexcept override
+  {
+    return statistics_;
+  }
+
+  void reset_statistics() noexcept override
+  {
+    statistics_ = {};
+  }
+
+protected:
+  Connection_statistics statistics_;
+  std::shared_ptr<const Statement_manifest> statement_manifest_;
+
+  virtual bool is_invariant_ok() = 0;
+
+  virtual std::string error_message() const = 0;
 };
 
 inline bool iConnection::is_invariant_ok()
@@ -463,6 +597,8 @@ public:
   {
     DMITIGR_REQUIRE(is_connected(), std::logic_error);
 
+    std::optional<Request_info> finished_request_info;
+
     const auto consume_input = [this]()
     {
       while (socket_readiness(Socket_readiness::read_ready) == Socket_readiness::read_ready) {
@@ -498,6 +634,16 @@ public:
       return pending_result_ && (pending_result_.status() == PGRES_FATAL_ERROR);
     };
 
+    // Returns `true` if the end of the results of the current request is reached.
+    const auto get_result = [&](pq::Result& result)
+    {
+      if (!is_get_result_would_block()) {
+        result.reset(::PQgetResult(conn_));
+        return !result && !requests_.empty() && requests_.front().id != Request_id::sync;
+      } else
+        return false;
+    };
+
     const auto is_request_done = [&]()
     {
       consume_input();
@@ -529,14 +675,11 @@ public:
         return false; // busy
     };
 
-    const auto next_result = [&]()
-    {
-      DMITIGR_ASSERT(!is_pending_result_error());
-      if (pending_result_)
-        return std::move(pending_result_);
-      else
-        return !is_get_result_would_block() ? pq::Result{::PQgetResult(conn_)} : pq::Result{};
-    };
+    if (is_pipeline_flush_required_) {
+      if (!::PQsendFlushRequest(conn_) || ::PQflush(conn_) != 0)
+        throw std::runtime_error(error_message());
+      is_pipeline_flush_required_ = false;
+    }
 
     if (is_pending_result_error())
       goto almost_done;
@@ -547,23 +690,48 @@ public:
     if (is_response_available())
       goto done;
 
-    if (auto r = next_result(); !r) {
+    if (pending_completion_) {
+      // The Row_set is already delivered.
+      response_ = std::move(*pending_completion_);
+      pending_completion_.reset();
+      goto almost_done;
+    }
+
+    if (pq::Result r{std::move(pending_result_)}; !r && get_result(r)) {
+      /*
+       * The end of results of the request whose last response is already
+       * delivered (is_request_done() was busy when the last response was
+       * processed).
+       */
+      goto request_done;
+    } else if (!r) {
       DMITIGR_ASSERT(::PQisBusy(conn_) || requests_.empty());
       goto done;
     } else /* processing the new result */ {
       DMITIGR_ASSERT(!pending_result_ && r && (r.status() != PGRES_NONFATAL_ERROR) && !response_ && !requests_.empty());
       const auto s = r.status();
-      const auto op_id = requests_.front();
+      auto& request = requests_.front();
+      const auto op_id = request.id;
       switch (s) {
       case PGRES_SINGLE_TUPLE:
         DMITIGR_ASSERT(op_id == Request_id::perform || op_id == Request_id::execute);
         if (!shared_field_names_)
-          shared_field_names_ = pq_Row_info::make_shared_field_names(r);
-        response_ = pq_Row(pq_Row_info(std::move(r), shared_field_names_));
+          shared_field_names_ = shared_field_names(r, request);
+        request.count_rows(r);
+        response_.emplace(std::in_place_type<pq_Row>,
+          pq_Row_info(std::move(r), shared_field_names_), std::move(row_storage_));
         goto done;
 
       case PGRES_TUPLES_OK:
         DMITIGR_ASSERT(op_id == Request_id::perform || op_id == Request_id::execute);
+        if (request.row_processing == Row_processing::batch && r.row_count() > 0) {
+          request.count_rows(r);
+          simple_Completion completion{r.command_tag()};
+          auto field_names = shared_field_names(r, request);
+          response_ = pq_Row_set(pq_Row_info(std::move(r), std::move(field_names)));
+          pending_completion_ = std::move(completion);
+          goto done;
+        }
         response_ = simple_Completion(r.command_tag());
         goto almost_done;
 
@@ -581,23 +749,23 @@ public:
           goto almost_done;
 
         case Request_id::prepare_statement:
-          DMITIGR_ASSERT(request_prepared_statement_);
-          response_ = register_ps(std::move(*request_prepared_statement_));
+          DMITIGR_ASSERT(request.prepared_statement);
+          response_ = register_ps(std::move(*request.prepared_statement));
           goto almost_done;
 
         case Request_id::describe_prepared_statement: {
-          DMITIGR_ASSERT(request_prepared_statement_name_);
-          auto* p = ps(*request_prepared_statement_name_);
+          DMITIGR_ASSERT(request.prepared_statement_name);
+          auto* p = ps(*request.prepared_statement_name);
           if (!p)
-            p = register_ps(pq_Prepared_statement(std::move(*request_prepared_statement_name_), this, r.field_count()));
+            p = register_ps(pq_Prepared_statement(std::move(*request.prepared_statement_name), this, r.field_count()));
           p->set_description(std::move(r));
           response_ = p;
           goto almost_done;
         }
 
         case Request_id::unprepare_statement:
-          DMITIGR_ASSERT(request_prepared_statement_name_ && std::strcmp(r.command_tag(), "DEALLOCATE") == 0);
-          unregister_ps(*request_prepared_statement_name_);
+          DMITIGR_ASSERT(request.prepared_statement_name && std::strcmp(r.command_tag(), "DEALLOCATE") == 0);
+          unregister_ps(*request.prepared_statement_name);
           response_ = simple_Completion("unprepare_statement");
           goto almost_done;
 
@@ -612,24 +780,52 @@ public:
         response_ = simple_Completion("invalid response");
         goto almost_done;
 
+      case PGRES_PIPELINE_SYNC:
+        DMITIGR_ASSERT(op_id == Request_id::sync);
+        response_ = simple_Completion("pipeline_sync");
+        goto request_done; // Note: the pipeline sync result is not followed by the null result.
+
+      case PGRES_COPY_IN:
+        [[fallthrough]];
+
+      case PGRES_COPY_OUT:
+        DMITIGR_ASSERT(op_id == Request_id::perform || op_id == Request_id::execute);
+        copier_.emplace(this, std::move(r));
+        response_ = &*copier_;
+        goto done; // Note: the results of the request are collected after the data transfer.
+
+      case PGRES_PIPELINE_ABORTED:
+        response_ = simple_Completion("pipeline_aborted");
+        goto almost_done;
+
       default: DMITIGR_ASSERT(!true);
       } // switch (status)
     } // if (next result)
 
   almost_done:
-    if (is_request_done()) {
-      shared_field_names_.reset();
-      request_prepared_statement_.reset();
-      request_prepared_statement_name_.reset();
+    if (!is_request_done())
+      goto done;
 
-      if (error())
-        requests_.clear();
-      else
-        requests_.pop();
-    }
+  request_done:
+    shared_field_names_.reset();
+    finished_request_info = request_finished(requests_.front());
+    if (error() && !is_pipeline_enabled())
+      requests_.clear();
+    else
+      requests_.pop();
+
+    /*
+     * In pipeline mode the single-row mode can be activated only when
+     * the results of the query are about to be processed.
+     */
+    if (!requests_.empty())
+      set_single_row_mode_if_rows_expected();
 
   done:
     DMITIGR_ASSERT(is_invariant_ok());
+
+    if (finished_request_info && request_finish_handler_)
+      request_finish_handler_(*finished_request_info);
   }
 
   bool is_signal_available() const noexcept override
@@ -720,6 +916,28 @@ public:
     }
   }
 
+  void set_request_start_handler(const std::function<void(const Request_info&)>& handler) override
+  {
+    request_start_handler_ = handler;
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  std::function<void(const Request_info&)> request_start_handler() const override
+  {
+    return request_start_handler_;
+  }
+
+  void set_request_finish_handler(const std::function<void(const Request_info&)>& handler) override
+  {
+    request_finish_handler_ = handler;
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  std::function<void(const Request_info&)> request_finish_handler() const override
+  {
+    return request_finish_handler_;
+  }
+
   bool is_awaiting_response() const noexcept override
   {
     return !requests_.empty();
@@ -732,6 +950,9 @@ public:
 
   void dismiss_response() noexcept override
   {
+    // The storage of the row is retained for the next one.
+    if (auto* const r = response_ptr<pq_Row>())
+      row_storage_ = r->release_storage();
     response_.reset();
   }
 
@@ -755,6 +976,21 @@ public:
     return release_response<Row, pq_Row>();
   }
 
+  const pq_Row_set* row_set() const noexcept override
+  {
+    return response_ptr<pq_Row_set>();
+  }
+
+  std::unique_ptr<Row_set> release_row_set() override
+  {
+    return release_response<Row_set, pq_Row_set>();
+  }
+
+  pq_Copier* copier() const noexcept override
+  {
+    return response_ptr<pq_Copier>();
+  }
+
   const simple_Completion* completion() const noexcept override
   {
     return response_ptr<simple_Completion>();
@@ -775,32 +1011,88 @@ public:
     return ps(name);
   }
 
+  std::size_t prepared_statement_count() const noexcept override
+  {
+    return named_prepared_statements_.size() + bool(unnamed_prepared_statement_);
+  }
+
+  std::size_t prepared_statement_memory_usage() const noexcept override
+  {
+    std::size_t result = named_prepared_statements_.bucket_count() * sizeof(void*);
+    for (const auto& [name, ps] : named_prepared_statements_)
+      result += name.capacity() + ps.memory_size();
+    if (unnamed_prepared_statement_)
+      result += unnamed_prepared_statement_->memory_size();
+    return result;
+  }
+
   bool is_ready_for_async_request() const override
   {
-    return is_connected() && requests_.empty() && (!response_ || completion() || prepared_statement());
+    return is_connected() &&
+      (requests_.empty() || is_pipeline_enabled()) &&
+      (!response_ || completion() || prepared_statement());
   }
 
   bool is_ready_for_request() const override
   {
-    // At the moment, is_ready_for_request() is similar to is_ready_for_async_request().
-    return is_ready_for_async_request();
+    return is_ready_for_async_request() && requests_.empty();
+  }
+
+  void set_pipeline_enabled(const bool value) override
+  {
+    DMITIGR_REQUIRE(is_connected() && !is_awaiting_response(), std::logic_error);
+
+    if (value != is_pipeline_enabled()) {
+      const int ok = value ? ::PQenterPipelineMode(conn_) : ::PQexitPipelineMode(conn_);
+      if (!ok)
+        throw std::runtime_error(error_message());
+    }
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  bool is_pipeline_enabled() const override
+  {
+    return conn_ && (::PQpipelineStatus(conn_) != PQ_PIPELINE_OFF);
+  }
+
+  void synchronize_pipeline_async() override
+  {
+    DMITIGR_REQUIRE(is_pipeline_enabled() && is_ready_for_async_request(), std::logic_error);
+
+    requests_.push(Request{Request_id::sync}); // can throw
+    try {
+      const auto send_ok = ::PQpipelineSync(conn_);
+      if (!send_ok)
+        throw std::runtime_error(error_message());
+      request_sent(); // cannot throw
+      is_pipeline_flush_required_ = false; // ::PQpipelineSync() flushes
+    } catch (...) {
+      requests_.pop_back(); // rollback
+      throw;
+    }
+
+    DMITIGR_ASSERT(is_invariant_ok());
   }
 
   void perform_async(const std::string& queries) override
   {
     DMITIGR_REQUIRE(is_ready_for_async_request(), std::logic_error);
 
-    requests_.push(Request_id::perform); // can throw
+    push_request(Request{Request_id::perform}, {}, queries); // can throw
     try {
-      const auto send_ok = ::PQsendQuery(conn_, queries.c_str());
+      /*
+       * Note: ::PQsendQuery() uses the simple query protocol which is
+       * not allowed in the pipeline mode.
+       */
+      const auto send_ok = !is_pipeline_enabled() ? ::PQsendQuery(conn_, queries.c_str()) :
+        ::PQsendQueryParams(conn_, queries.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 0);
       if (!send_ok)
         throw std::runtime_error(error_message());
 
-      const auto set_ok = ::PQsetSingleRowMode(conn_);
-      DMITIGR_ASSERT_ALWAYS(set_ok);
-      dismiss_response(); // cannot throw
+      request_sent(); // cannot throw
     } catch (...) {
-      requests_.pop(); // rollback
+      cancel_request(); // rollback
       throw;
     }
 
@@ -820,9 +1112,8 @@ private:
   {
     DMITIGR_ASSERT(query && name);
     DMITIGR_REQUIRE(is_ready_for_async_request(), std::logic_error);
-    DMITIGR_ASSERT(!request_prepared_statement_);
 
-    requests_.push(Request_id::prepare_statement); // can throw
+    push_request(Request{Request_id::prepare_statement}, name, query); // can throw
     try {
       pq_Prepared_statement ps{name, this, preparsed};
       constexpr int n_params{0};
@@ -830,10 +1121,10 @@ private:
       const int send_ok = ::PQsendPrepare(conn_, name, query, n_params, param_types);
       if (!send_ok)
         throw std::runtime_error(error_message());
-      request_prepared_statement_ = std::move(ps); // cannot throw
-      dismiss_response(); // cannot throw
+      requests_.back().prepared_statement = std::move(ps); // cannot throw
+      request_sent(); // cannot throw
     } catch (...) {
-      requests_.pop(); // rollback
+      cancel_request(); // rollback
       throw;
     }
 
@@ -846,7 +1137,7 @@ public:
     DMITIGR_REQUIRE(statement && !statement->has_missing_parameters(), std::invalid_argument);
     const auto* const s = dynamic_cast<const iSql_string*>(statement);
     DMITIGR_ASSERT(s);
-    prepare_statement_async__(s->to_query_string().c_str(), name.c_str(), s); // can throw
+    prepare_statement_async__(s->query_string().c_str(), name.c_str(), s); // can throw
   }
 
   void prepare_statement_async(const std::string& query, const std::string& name = {}) override
@@ -857,18 +1148,17 @@ public:
   void describe_prepared_statement_async(const std::string& name) override
   {
     DMITIGR_REQUIRE(is_ready_for_async_request(), std::logic_error);
-    DMITIGR_ASSERT(!request_prepared_statement_name_);
 
-    requests_.push(Request_id::describe_prepared_statement); // can throw
+    push_request(Request{Request_id::describe_prepared_statement}, name); // can throw
     try {
       auto name_copy = name;
       const int send_ok = ::PQsendDescribePrepared(conn_, name.c_str());
       if (!send_ok)
         throw std::runtime_error(error_message());
-      request_prepared_statement_name_ = std::move(name_copy); // cannot throw
-      dismiss_response(); // cannot throw
+      requests_.back().prepared_statement_name = std::move(name_copy); // cannot throw
+      request_sent(); // cannot throw
     } catch (...) {
-      requests_.pop(); // rollback
+      cancel_request(); // rollback
       throw;
     }
 
@@ -878,19 +1168,74 @@ public:
   void unprepare_statement_async(const std::string& name) override
   {
     DMITIGR_REQUIRE(!name.empty(), std::invalid_argument);
-    DMITIGR_ASSERT(!request_prepared_statement_name_);
 
     auto name_copy = name; // can throw
     const auto query = "DEALLOCATE " + to_quoted_identifier(name); // can throw
 
     perform_async(query); // can throw
-    DMITIGR_ASSERT(requests_.front() == Request_id::perform);
-    requests_.front() = Request_id::unprepare_statement; // cannot throw
-    request_prepared_statement_name_ = std::move(name_copy); // cannot throw
+    auto& request = requests_.back();
+    DMITIGR_ASSERT(request.id == Request_id::perform);
+    request.id = Request_id::unprepare_statement; // cannot throw
+    request.prepared_statement_name = std::move(name_copy); // cannot throw
 
     DMITIGR_ASSERT(is_invariant_ok());
   }
 
+private:
+  template<typename T>
+  pq_Prepared_statement* cached_prepared_statement__(std::string key, T&& statement)
+  {
+    DMITIGR_REQUIRE(ps_cache_capacity_ > 0 && is_ready_for_request(), std::logic_error);
+
+    // Cache hit.
+    if (const auto i = ps_cache_index_.find(key); i != cend(ps_cache_index_)) {
+      ps_cache_.splice(begin(ps_cache_), ps_cache_, i->second); // cannot throw
+      // The formats of the connection could be changed since the preparation.
+      auto* const ps = i->second->ps;
+      ps->set_parameter_format(parameter_format());
+      ps->set_result_format(result_format());
+      return ps;
+    }
+
+    // Cache miss.
+    if (ps_cache_.size() >= ps_cache_capacity_)
+      unprepare_statement(ps_cache_.back().ps->name()); // can throw (removes from the cache)
+    DMITIGR_ASSERT(ps_cache_.size() < ps_cache_capacity_);
+
+    const auto name = "pgfe_cached_ps_" + std::to_string(++ps_cache_name_counter_); // can throw
+    prepare_statement(std::forward<T>(statement), name); // can throw
+    auto* const ps = prepared_statement();
+    DMITIGR_ASSERT(ps);
+
+    /*
+     * Note: if the following code throws, the statement just prepared is
+     * merely not cached.
+     */
+    ps_cache_.push_front(Ps_cache_entry{std::move(key), ps}); // can throw
+    try {
+      ps_cache_index_.emplace(ps_cache_.front().key, begin(ps_cache_)); // can throw
+    } catch (...) {
+      ps_cache_.pop_front(); // rollback
+      throw;
+    }
+
+    DMITIGR_ASSERT(is_invariant_ok());
+    return ps_cache_.front().ps;
+  }
+
+public:
+  void set_parameter_format(const Data_format format) override
+  {
+    default_parameter_format_ = format;
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  Data_format parameter_format() const noexcept override
+  {
+    return default_parameter_format_;
+  }
+
   void set_result_format(const Data_format format) override
   {
     default_result_format_ = format;
@@ -903,9 +1248,54 @@ public:
     return default_result_format_;
   }
 
+  void set_prepared_statement_cache_capacity(const std::size_t value) override
+  {
+    DMITIGR_REQUIRE(value >= ps_cache_.size() || is_ready_for_request(), std::logic_error);
+
+    while (ps_cache_.size() > value)
+      unprepare_statement(ps_cache_.back().ps->name()); // can throw (removes from the cache)
+    ps_cache_capacity_ = value;
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  std::size_t prepared_statement_cache_capacity() const noexcept override
+  {
+    return ps_cache_capacity_;
+  }
+
+  std::size_t prepared_statement_cache_size() const noexcept override
+  {
+    return ps_cache_.size();
+  }
+
+  pq_Prepared_statement* cached_prepared_statement(const Sql_string* const statement) override
+  {
+    DMITIGR_REQUIRE(statement && !statement->has_missing_parameters(), std::invalid_argument);
+    return cached_prepared_statement__(statement->to_string(), statement);
+  }
+
+  pq_Prepared_statement* cached_prepared_statement(const std::string& statement) override
+  {
+    return cached_prepared_statement__(statement, statement);
+  }
+
+  void set_row_processing(const Row_processing value) override
+  {
+    row_processing_ = value;
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  Row_processing row_processing() const noexcept override
+  {
+    return row_processing_;
+  }
+
   void for_each(const std::function<void(const Row*)>& body) override
   {
     DMITIGR_REQUIRE(body, std::invalid_argument);
+    DMITIGR_REQUIRE(!row_set(), std::logic_error);
 
     while (const auto* const r = row()) {
       body(r);
@@ -917,6 +1307,7 @@ public:
   void for_each(const std::function<void(std::unique_ptr<Row>&&)>& body) override
   {
     DMITIGR_REQUIRE(body, std::invalid_argument);
+    DMITIGR_REQUIRE(!row_set(), std::logic_error);
 
     while (auto r = release_row()) {
       body(std::move(r));
@@ -995,18 +1386,26 @@ protected:
       !polling_status_ ||
       (*polling_status_ == Status::establishment_reading) ||
       (*polling_status_ == Status::establishment_writing);
-    const bool requests_ok = requests_.empty() || !is_ready_for_async_request();
-    const bool request_prepared_ok =
-      requests_.empty() ||
-      (requests_.front() != Request_id::prepare_statement &&
-        requests_.front() != Request_id::describe_prepared_statement &&
-        requests_.front() != Request_id::unprepare_statement &&
-        !request_prepared_statement_ && !request_prepared_statement_name_) ||
-      (requests_.front() == Request_id::prepare_statement &&
-        request_prepared_statement_ && !request_prepared_statement_name_) ||
-      ((requests_.front() == Request_id::describe_prepared_statement ||
-        requests_.front() == Request_id::unprepare_statement) &&
-        !request_prepared_statement_ && request_prepared_statement_name_);
+    const bool requests_ok = requests_.empty() || !is_ready_for_async_request() || is_pipeline_enabled();
+    const bool request_prepared_ok = std::all_of(requests_.cbegin(), requests_.cend(),
+      [](const Request& request)
+      {
+        const auto id = request.id;
+        return (id != Request_id::prepare_statement &&
+          id != Request_id::describe_prepared_statement &&
+          id != Request_id::unprepare_statement &&
+          !request.prepared_statement &&
+          (!request.prepared_statement_name || id == Request_id::execute)) ||
+          (id == Request_id::prepare_statement &&
+            request.prepared_statement && !request.prepared_statement_name) ||
+          ((id == Request_id::describe_prepared_statement ||
+            id == Request_id::unprepare_statement) &&
+            !request.prepared_statement && request.prepared_statement_name);
+      });
+    const bool pipeline_ok = !is_pipeline_flush_required_ || is_pipeline_enabled();
+    const bool ps_cache_ok = (ps_cache_.size() <= ps_cache_capacity_) &&
+      (ps_cache_.size() == ps_cache_index_.size()) &&
+      std::all_of(cbegin(ps_cache_), cend(ps_cache_), [](const auto& entry) { return entry.ps; });
     const bool shared_field_names_ok = !row() || shared_field_names_;
     const bool session_start_time_ok =
       ((communication_status() == Communication_status::connected) == bool(session_start_time_));
@@ -1015,14 +1414,15 @@ protected:
       signals_.empty() &&
       !response_ &&
       !pending_result_ &&
+      !pending_completion_ &&
       !transaction_block_status_ &&
       !server_pid_ &&
       named_prepared_statements_.empty() &&
       !unnamed_prepared_statement_ &&
       !shared_field_names_ &&
+      ps_cache_.empty() &&
       requests_.empty() &&
-      !request_prepared_statement_ &&
-      !request_prepared_statement_name_;
+      !is_pipeline_flush_required_;
     const bool session_data_ok =
       session_data_empty ||
       ((communication_status() == Communication_status::failure) || (communication_status() == Communication_status::connected));
@@ -1033,6 +1433,8 @@ protected:
       polling_status_ok &&
       requests_ok &&
       request_prepared_ok &&
+      pipeline_ok &&
+      ps_cache_ok &&
       shared_field_names_ok &&
       session_start_time_ok &&
       session_data_ok &&
@@ -1051,6 +1453,7 @@ protected:
   }
 
 private:
+  friend pq_Copier;
   friend pq_Prepared_statement;
 
   // ---------------------------------------------------------------------------
@@ -1063,9 +1466,15 @@ private:
   // Persistent data / public-modifiable data
   std::function<void(std::unique_ptr<Notice>&&)> notice_handler_;
   std::function<void(std::unique_ptr<Notification>&&)> notification_handler_;
+  std::function<void(const Request_info&)> request_start_handler_;
+  std::function<void(const Request_info&)> request_finish_handler_;
+  Data_format default_parameter_format_{Data_format::text};
   Data_format default_result_format_{Data_format::text};
+  Row_processing row_processing_{Row_processing::single};
+  std::size_t ps_cache_capacity_{};
 
   // Persistent data / private-modifiable data
+  std::uint_fast64_t ps_cache_name_counter_{};
   ::PGconn* conn_{nullptr};
   std::optional<Communication_status> polling_status_;
 
@@ -1079,14 +1488,29 @@ private:
   mutable std::list<Signal_> signals_;
 
   using Response_ = std::optional<std::variant<std::monostate,
-    simple_Error, pq_Row, simple_Completion, pq_Prepared_statement*>>;
+    simple_Error, pq_Row, pq_Row_set, simple_Completion, pq_Prepared_statement*, pq_Copier*>>;
   mutable Response_ response_;
+  std::optional<pq_Copier> copier_;
+  std::vector<Data_view> row_storage_; // the storage of the dismissed row
   pq::Result pending_result_;
+  std::optional<simple_Completion> pending_completion_; // follows the Row_set
   mutable std::optional<Transaction_block_status> transaction_block_status_;
   mutable std::optional<std::int_fast32_t> server_pid_;
-  mutable std::list<pq_Prepared_statement> named_prepared_statements_;
+  mutable std::unordered_map<std::string, pq_Prepared_statement> named_prepared_statements_; // node-based (stable addresses)
   mutable std::optional<pq_Prepared_statement> unnamed_prepared_statement_;
-  std::shared_ptr<std::vector<std::string>> shared_field_names_;
+  std::shared_ptr<const Field_names> shared_field_names_;
+
+  // -----------------------------------------
+  // Session data / prepared statements cache
+  // -----------------------------------------
+
+  struct Ps_cache_entry final {
+    std::string key;
+    pq_Prepared_statement* ps{};
+  };
+
+  std::list<Ps_cache_entry> ps_cache_; // the first is the most recently used
+  std::unordered_map<std::string_view, std::list<Ps_cache_entry>::iterator> ps_cache_index_; // keys are views of Ps_cache_entry::key
 
   // ----------------------------
   // Session data / requests data
@@ -1097,17 +1521,48 @@ private:
     execute,
     prepare_statement,
     describe_prepared_statement,
-    unprepare_statement
+    unprepare_statement,
+    sync
+  };
+
+  struct Request final {
+    explicit Request(const Request_id rid)
+      : id{rid}
+    {}
+
+    Request_id id{};
+    Row_processing row_processing{};
+    std::optional<pq_Prepared_statement> prepared_statement;
+    std::optional<std::string> prepared_statement_name;
+    std::chrono::steady_clock::time_point start_time;
+    std::size_t row_count{};
+    std::size_t byte_count{};
+    std::optional<Request_info> info; // only if instrumented
+    bool is_started{}; // the request start handler is called
+
+    // Counts the rows of the result and the size of their data.
+    void count_rows(const pq::Result& r) noexcept
+    {
+      const int rc = r.row_count();
+      const int fc = r.field_count();
+      for (int i = 0; i < rc; ++i) {
+        for (int j = 0; j < fc; ++j)
+          byte_count += std::size_t(r.data_size(i, j));
+      }
+      row_count += std::size_t(rc);
+    }
   };
 
-  class Requests_queue final : public std::queue<Request_id> {
+  class Requests_queue final : public std::queue<Request> {
   public:
     void clear() { c.clear(); }
+    void pop_back() { c.pop_back(); }
+    container_type::const_iterator cbegin() const { return c.cbegin(); }
+    container_type::const_iterator cend() const { return c.cend(); }
   };
 
-  Requests_queue requests_; // for now only 1 request can be queued
-  std::optional<pq_Prepared_statement> request_prepared_statement_;
-  std::optional<std::string> request_prepared_statement_name_;
+  Requests_queue requests_; // more than 1 request can be queued only in pipeline mode
+  bool is_pipeline_flush_required_{};
 
   // ---------------------------------------------------------------------------
   // Handlers
@@ -1136,15 +1591,153 @@ private:
     session_start_time_.reset();
     signals_.clear();
     response_.reset();
+    copier_.reset();
     pending_result_.reset();
+    pending_completion_.reset();
     transaction_block_status_.reset();
     server_pid_.reset();
     named_prepared_statements_.clear();
     unnamed_prepared_statement_.reset();
     shared_field_names_.reset();
-    requests_.clear();
-    request_prepared_statement_.reset();
-    request_prepared_statement_name_.reset();
+    ps_cache_index_.clear();
+    ps_cache_.clear();
+    while (!requests_.empty()) {
+      abandon_request(requests_.front());
+      requests_.pop();
+    }
+    is_pipeline_flush_required_ = false;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Requests helpers
+  // ---------------------------------------------------------------------------
+
+  /*
+   * Queues the request and calls the request start handler (if any).
+   *
+   * Exception safety guarantee: strong.
+   */
+  void push_request(Request&& request, const std::string& name = {},
+    const std::string& query = {}, const std::size_t parameter_count = 0)
+  {
+    if (request_start_handler_ || request_finish_handler_) {
+      auto& info = request.info.emplace();
+      info.name = name;
+      info.query = query;
+      info.parameter_count = parameter_count;
+    }
+
+    requests_.push(std::move(request)); // can throw
+    if (request_start_handler_) {
+      try {
+        request_start_handler_(*requests_.back().info);
+      } catch (...) {
+        requests_.pop_back(); // rollback
+        throw;
+      }
+      requests_.back().is_started = true;
+    }
+    requests_.back().start_time = std::chrono::steady_clock::now();
+  }
+
+  /*
+   * Removes the last request which is queued by push_request() but failed to
+   * be sent.
+   */
+  void cancel_request() noexcept
+  {
+    DMITIGR_ASSERT_NOTHROW(!requests_.empty());
+    auto request = std::move(requests_.back());
+    requests_.pop_back();
+    abandon_request(request);
+  }
+
+  /*
+   * Calls the request finish handler (as for the failed request) for the
+   * `request` which will never be finished if the request start handler was
+   * called for it. The exception thrown by the handler is ignored, since this
+   * function is called upon the handling of another exception or upon the
+   * disconnection.
+   */
+  void abandon_request(Request& request) noexcept
+  {
+    if (request.is_started && request_finish_handler_) {
+      DMITIGR_ASSERT_NOTHROW(request.info);
+      request.info->elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - request.start_time);
+      request.info->is_failed = true;
+      try {
+        request_finish_handler_(*request.info);
+      } catch (...) {}
+    }
+  }
+
+  /*
+   * Accounts the finished request in the statistics.
+   *
+   * @returns The information about the request if instrumented.
+   */
+  std::optional<Request_info> request_finished(Request& request) noexcept
+  {
+    if (request.id == Request_id::sync)
+      return std::nullopt;
+
+    const auto elapsed = std::chrono::steady_clock::now() - request.start_time;
+    const bool is_failed = error();
+    statistics_.request_count++;
+    statistics_.error_count += is_failed;
+    statistics_.row_count += request.row_count;
+    statistics_.byte_count += request.byte_count;
+    const auto& bounds = Connection_statistics::duration_bucket_bounds;
+    const auto bucket = std::upper_bound(cbegin(bounds), cend(bounds), elapsed) - cbegin(bounds);
+    statistics_.duration_histogram[std::size_t(bucket)]++;
+
+    if (request.info) {
+      request.info->elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+      request.info->row_count = request.row_count;
+      request.info->byte_count = request.byte_count;
+      request.info->is_failed = is_failed;
+    }
+    return std::move(request.info);
+  }
+
+  /*
+   * Completes the submission of the request which is already sent (and
+   * queued in the requests_).
+   *
+   * Exception safety guarantee: nothrow.
+   */
+  void request_sent() noexcept
+  {
+    DMITIGR_ASSERT_NOTHROW(!requests_.empty());
+    DMITIGR_ASSERT_NOTHROW(requests_.size() == 1 || is_pipeline_enabled());
+    requests_.back().row_processing = row_processing_;
+    if (requests_.size() == 1) {
+      set_single_row_mode_if_rows_expected();
+      dismiss_response();
+    }
+    /*
+     * Otherwise, the response to the preceding request is not dismissed since
+     * it must be delivered to the caller in pipeline mode.
+     */
+
+    if (is_pipeline_enabled())
+      is_pipeline_flush_required_ = true;
+  }
+
+  /*
+   * Activates the single-row mode for the query which results are about to
+   * be processed (that is the query of the first request in the queue).
+   */
+  void set_single_row_mode_if_rows_expected() noexcept
+  {
+    DMITIGR_ASSERT_NOTHROW(!requests_.empty());
+    const auto& request = requests_.front();
+    if ((request.id == Request_id::perform || request.id == Request_id::execute) &&
+      request.row_processing == Row_processing::single) {
+      const auto set_ok = ::PQsetSingleRowMode(conn_);
+      DMITIGR_ASSERT_NOTHROW(set_ok);
+    }
   }
 
   // ---------------------------------------------------------------------------
@@ -1159,14 +1752,8 @@ private:
   pq_Prepared_statement* ps(const std::string& name) const
   {
     if (!name.empty()) {
-      const auto b = begin(named_prepared_statements_);
-      const auto e = end(named_prepared_statements_);
-      auto p = std::find_if(b, e,
-        [&name](const auto& ps)
-        {
-          return (ps.name() == name);
-        });
-      return (p != e) ? &*p : nullptr;
+      const auto i = named_prepared_statements_.find(name);
+      return (i != end(named_prepared_statements_)) ? &i->second : nullptr;
     } else
       return unnamed_prepared_statement_ ? &*unnamed_prepared_statement_ : nullptr;
   }
@@ -1182,8 +1769,12 @@ private:
       unnamed_prepared_statement_ = std::move(ps);
       return &*unnamed_prepared_statement_;
     } else {
-      named_prepared_statements_.push_front(std::move(ps));
-      return &named_prepared_statements_.front();
+      /*
+       * Note: if the statement with the same name is already registered, it's
+       * replaced in-place so the pointers to it remains valid.
+       */
+      auto name = ps.name(); // can throw
+      return &named_prepared_statements_.insert_or_assign(std::move(name), std::move(ps)).first->second;
     }
   }
 
@@ -1192,8 +1783,35 @@ private:
   {
     if (name.empty())
       unnamed_prepared_statement_.reset();
-    else
-      named_prepared_statements_.remove_if([&](const auto& ps){ return ps.name() == name; });
+    else {
+      if (!ps_cache_.empty()) {
+        const auto e = end(ps_cache_);
+        if (const auto i = std::find_if(begin(ps_cache_), e,
+            [&](const auto& entry){ return entry.ps->name() == name; }); i != e) {
+          ps_cache_index_.erase(i->key);
+          ps_cache_.erase(i);
+        }
+      }
+      named_prepared_statements_.erase(name);
+    }
+  }
+
+  /*
+   * @returns The field names of the result `r` of the `request`. The field
+   * names of the rows produced by the prepared statement are cached by the
+   * prepared statement to be reused by the subsequent executions.
+   */
+  std::shared_ptr<const Field_names> shared_field_names(const pq::Result& r, const Request& request) const
+  {
+    if (request.id == Request_id::execute && request.prepared_statement_name) {
+      if (auto* const p = ps(*request.prepared_statement_name)) {
+        auto& cached = p->shared_field_names_;
+        if (!cached || !cached->is_matching(r))
+          cached = pq_Row_info::make_shared_field_names(r);
+        return cached;
+      }
+    }
+    return pq_Row_info::make_shared_field_names(r);
   }
 
   // ---------------------------------------------------------------------------
@@ -1353,6 +1971,22 @@ inline std::unique_ptr<Connection> iConnection_options::make_connection() const
 
 namespace dmitigr::pgfe {
 
+DMITIGR_PGFE_INLINE std::shared_ptr<const Statement_manifest>
+to_statement_manifest(const Sql_vector& sql_vector, const std::string& extra_name)
+{
+  DMITIGR_REQUIRE(!extra_name.empty(), std::invalid_argument);
+
+  auto result = std::make_shared<Statement_manifest>();
+  for (std::size_t i = 0; i < sql_vector.sql_string_count(); ++i) {
+    const auto* const statement = sql_vector.sql_string(i);
+    const auto* const extra = statement->extra();
+    const auto index = extra ? extra->field_index(extra_name) : std::nullopt;
+    if (const auto* const name = index ? extra->data(*index) : nullptr)
+      result->emplace_back(std::string(name->bytes(), name->size()), statement->to_sql_string());
+  }
+  return result;
+}
+
 DMITIGR_PGFE_INLINE std::unique_ptr<Connection> Connection::make(const Connection_options* const options)
 {
   if (options)
@@ -6,6 +6,7 @@
 #define DMITIGR_PGFE_CONNECTION_HPP
 
 #include "dmitigr/pgfe/dll.hpp"
+#include "dmitigr/pgfe/instrumentation.hpp"
 #include "dmitigr/pgfe/prepared_statement_dfn.hpp"
 #include "dmitigr/pgfe/types_fwd.hpp"
 
@@ -15,9 +16,38 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace dmitigr::pgfe {
 
+/**
+ * @ingroup main
+ *
+ * @brief The statement manifest - the pairs of the names and the SQL strings
+ * of the statements to prepare.
+ *
+ * @see to_statement_manifest(), Connection::set_statement_manifest().
+ */
+using Statement_manifest = std::vector<std::pair<std::string, std::unique_ptr<const Sql_string>>>;
+
+/**
+ * @ingroup main
+ *
+ * @returns The statement manifest made of the copies of the SQL strings of
+ * `sql_vector` which have the extra data named by `extra_name`. The value of
+ * such an extra data is the name of the prepared statement. The SQL strings
+ * without it are ignored.
+ *
+ * @par Requires
+ * `!extra_name.empty()`.
+ *
+ * @par Exception safety guarantee
+ * Strong.
+ */
+DMITIGR_PGFE_API std::shared_ptr<const Statement_manifest>
+to_statement_manifest(const Sql_vector& sql_vector, const std::string& extra_name);
+
 /**
  * @ingroup main
  *
@@ -147,12 +177,14 @@ public:
    *
    * @throws Client_exception with code of Client_errc::timed_out if the
    * `(connection_status() == Communication_status::connected)` will not
-   * evaluates to `true` within the specified `timeout`.
+   * evaluates to `true` within the specified `timeout`, or if the statements
+   * of statement_manifest() are not prepared within the rest of the `timeout`.
    *
    * @par Exception safety guarantee
-   * Basic.
+   * Basic. If the statements of statement_manifest() are failed to prepare,
+   * the connection is closed.
    *
-   * @see connect_async().
+   * @see connect_async(), set_statement_manifest().
    */
   virtual void connect(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) = 0;
 
@@ -370,6 +402,77 @@ public:
 
   // ---------------------------------------------------------------------------
 
+  /// @name Instrumentation
+  /// @{
+
+  /**
+   * @brief Sets the handler which is called upon the submission of each
+   * request (except the synchronization points of the pipeline).
+   *
+   * By default, a request start handler isn't set.
+   *
+   * @param handler - the handler to set. The handler is called with the
+   * Request_info which contains the name, the query and the parameter count.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The request is not submitted if the handler throws.
+   */
+  virtual void set_request_start_handler(const std::function<void(const Request_info&)>& handler) = 0;
+
+  /**
+   * @returns The current request start handler.
+   */
+  virtual std::function<void(const Request_info&)> request_start_handler() const = 0;
+
+  /**
+   * @brief Sets the handler which is called when the last response to the
+   * request (except the synchronization point of the pipeline) is collected.
+   *
+   * By default, a request finish handler isn't set.
+   *
+   * @param handler - the handler to set. The handler is called with the
+   * complete Request_info.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The handler is called for the requests submitted while either
+   * of the request handlers is set. It's also called (with the Request_info
+   * marked as failed) for each request for which the request start handler
+   * was called but which will never be finished: the request which is failed
+   * to be sent, and the requests which are awaited upon disconnect(). The
+   * exceptions thrown by the handler in these cases are ignored.
+   * @remarks The handler is called from within collect_server_messages().
+   */
+  virtual void set_request_finish_handler(const std::function<void(const Request_info&)>& handler) = 0;
+
+  /**
+   * @returns The current request finish handler.
+   */
+  virtual std::function<void(const Request_info&)> request_finish_handler() const = 0;
+
+  /**
+   * @returns The cumulative statistics of the requests of this connection.
+   *
+   * @remarks The statistics are collected regardless of the request handlers
+   * and are retained upon reconnection.
+   */
+  virtual const Connection_statistics& statistics() const noexcept = 0;
+
+  /**
+   * @brief Resets the statistics.
+   *
+   * @par Effects
+   * All of the members of `statistics()` are zeroed.
+   */
+  virtual void reset_statistics() noexcept = 0;
+
+  ///@}
+
+  // ---------------------------------------------------------------------------
+
   /// @name Responses
   /// @{
 
@@ -429,6 +532,17 @@ public:
    */
   virtual bool is_response_available() const noexcept = 0;
 
+  /**
+   * @brief Throws Server_exception if `(error() != nullptr)`.
+   *
+   * @par Effects
+   * `!error()`.
+   *
+   * @remarks This function is useful when the responses are awaited by using
+   * the non-blocking API.
+   */
+  virtual void throw_if_error() = 0;
+
   /**
    * @brief Dismissing the last available Response.
    *
@@ -504,6 +618,46 @@ public:
    */
   virtual std::unique_ptr<Row> release_row() = 0;
 
+  /**
+   * @returns The pointer to the instance of type Row_set if available, or
+   * `nullptr` otherwise.
+   *
+   * @remarks The object pointed by the returned value is owned by this instance.
+   *
+   * @see release_row_set(), set_row_processing().
+   */
+  virtual const Row_set* row_set() const noexcept = 0;
+
+  /**
+   * @returns The released instance of type Row_set if available, or
+   * `nullptr` otherwise.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @par Effects
+   * `(row_set() == nullptr)`.
+   *
+   * @see dismiss_response(), row_set().
+   */
+  virtual std::unique_ptr<Row_set> release_row_set() = 0;
+
+  /**
+   * @returns The pointer to the instance of type Copier if available, or
+   * `nullptr` otherwise.
+   *
+   * The Copier is the response to the `COPY ... FROM STDIN` and to the
+   * `COPY ... TO STDOUT` commands. It remains available until the data
+   * transfer is finished (or until the response is dismissed).
+   *
+   * @remarks The object pointed by the returned value is owned by this instance.
+   * A caller should always rely upon assumption that the pointer obtained by
+   * this function becomes invalid after the next request.
+   *
+   * @see Copier.
+   */
+  virtual Copier* copier() const noexcept = 0;
+
   /**
    * @returns The pointer to the instance of type Completion if available, or
    * `nullptr` otherwise.
@@ -549,11 +703,29 @@ public:
    * @param name - the name of the prepared statement.
    *
    * @remarks The object pointed by the returned value is owned by this instance.
+   * It remains valid until the statement is unprepared or the session ends.
+   *
+   * @remarks The lookup has constant complexity on average.
    *
    * @see describe_prepared_statement(), describe_prepared_statement_async().
    */
   virtual Prepared_statement* prepared_statement(const std::string& name) const = 0;
 
+  /**
+   * @returns The number of the prepared statements known by Connection
+   * (including the unnamed one).
+   */
+  virtual std::size_t prepared_statement_count() const noexcept = 0;
+
+  /**
+   * @returns The approximate number of bytes allocated for the prepared
+   * statements known by Connection (including their parameters and
+   * descriptions).
+   *
+   * @remarks The complexity is linear in the number of the prepared statements.
+   */
+  virtual std::size_t prepared_statement_memory_usage() const noexcept = 0;
+
   ///@}
 
   // ---------------------------------------------------------------------------
@@ -573,10 +745,80 @@ public:
    * @returns `true` if the connection is ready for requesting a server,
    * or `false` otherwise.
    *
+   * @remarks In the pipeline mode the connection is not ready for requesting
+   * a server in a blocking manner until all of the awaited responses are
+   * collected.
+   *
    * @see is_awaiting_response().
    */
   virtual bool is_ready_for_request() const = 0;
 
+  /**
+   * @brief Enables or disables the pipeline mode.
+   *
+   * In the pipeline mode the requests submitted by perform_async(),
+   * prepare_statement_async(), describe_prepared_statement_async(),
+   * unprepare_statement_async() and Prepared_statement::execute_async() are
+   * queued without waiting for the responses to the previously submitted
+   * requests. The responses are delivered strictly in the order of requests
+   * submission and must be drained (one by one) by using wait_response().
+   * The queued requests are flushed to the server automatically upon the
+   * responses collection.
+   *
+   * @param value - the value to set.
+   *
+   * @par Requires
+   * `(is_connected() && !is_awaiting_response())`.
+   *
+   * @par Effects
+   * `(is_pipeline_enabled() == value)`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The pipeline mode is the property of the session. Thus, it's
+   * disabled automatically upon disconnection.
+   *
+   * @remarks If the request provokes an Error in the pipeline mode then each
+   * of the subsequent requests submitted before the synchronization point
+   * is rejected with the Completion with the operation name
+   * "pipeline_aborted".
+   *
+   * @see synchronize_pipeline_async().
+   */
+  virtual void set_pipeline_enabled(bool value) = 0;
+
+  /**
+   * @returns `true` if the pipeline mode is enabled, or `false` otherwise.
+   *
+   * @see set_pipeline_enabled().
+   */
+  virtual bool is_pipeline_enabled() const = 0;
+
+  /**
+   * @brief Submits the synchronization point of the pipeline.
+   *
+   * The synchronization point closes the implicit transaction of the requests
+   * submitted since the previous synchronization point (unless they are
+   * submitted inside the transaction block explicitly started by `BEGIN`).
+   * It also ends the state of rejection of the requests after an Error.
+   *
+   * @par Awaited responses
+   * Completion with the operation name "pipeline_sync".
+   *
+   * @par Requires
+   * `(is_pipeline_enabled() && is_ready_for_async_request())`.
+   *
+   * @par Effects
+   * `is_awaiting_response()`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see set_pipeline_enabled().
+   */
+  virtual void synchronize_pipeline_async() = 0;
+
   /**
    * @brief Submits the SQL query(-es) to a server.
    *
@@ -584,7 +826,8 @@ public:
    *   - if the query provokes an error: Error;
    *   - if the query does not provokes producing rows: Completion;
    *   - if the query provokes producing rows: the set of Row (if any), and
-   *     finally the Completion.
+   *     finally the Completion. (Or the Row_set (if any rows), and finally
+   *     the Completion if `(row_processing() == Row_processing::batch)`.)
    *
    * @param queries - the string, containing the SQL query(-es). Adjacent
    * queries must be separated by a semicolon.
@@ -603,7 +846,9 @@ public:
    * if one of them provokes an Error, then the transaction will be aborted and
    * the queries which were not yet executed will be rejected.
    *
-   * @see prepare_statement_async().
+   * @remarks In the pipeline mode the `queries` must contain only one query.
+   *
+   * @see prepare_statement_async(), set_pipeline_enabled().
    */
   virtual void perform_async(const std::string& queries) = 0;
 
@@ -756,6 +1001,66 @@ public:
    */
   virtual void unprepare_statement(const std::string& name) = 0;
 
+  /**
+   * @brief Sets the statement manifest - the named SQL strings which are
+   * prepared automatically just after the connection is established by
+   * connect().
+   *
+   * Since the prepared statements are dropped when the session ends, they
+   * are prepared again upon each connect().
+   *
+   * @param manifest - the statement manifest, or `nullptr` to reset.
+   *
+   * @par Effects
+   * `(statement_manifest() == manifest)`. If `(manifest && is_connected())`
+   * then the statements are prepared immediately.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @remarks Since the manifest is immutable it can be shared between the
+   * connections used from different threads.
+   *
+   * @see to_statement_manifest(), prepare_statement_manifest().
+   */
+  virtual void set_statement_manifest(std::shared_ptr<const Statement_manifest> manifest) = 0;
+
+  /**
+   * @returns The current statement manifest.
+   */
+  virtual std::shared_ptr<const Statement_manifest> statement_manifest() const noexcept = 0;
+
+  /**
+   * @brief Prepares all of the statements of the statement manifest at once
+   * by using the pipeline.
+   *
+   * The statements which are already prepared with the same names are
+   * unprepared first, so the pointers to them become invalid.
+   *
+   * @param timeout - the maximum amount of time to wait for the responses.
+   * The value of `-1` means *eternity*.
+   *
+   * @par Requires
+   * `(timeout >= -1 && is_ready_for_request())`.
+   *
+   * @par Effects
+   * `prepared_statement(name)` for each statement of the manifest. The
+   * pipeline mode is unchanged.
+   *
+   * @throws Client_exception with code of Client_errc::timed_out if the
+   * responses are not received within the specified `timeout`. In this case
+   * the connection state is unspecified and it should be closed.
+   *
+   * @par Exception safety guarantee
+   * Basic. If some of the statements are failed to prepare, then the first
+   * error is thrown as Server_exception after all the responses are collected.
+   *
+   * @remarks This function is called by connect() automatically with the
+   * rest of its timeout. (It should be called explicitly only if the
+   * connection is established by using connect_async().)
+   */
+  virtual void prepare_statement_manifest(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) = 0;
+
   /**
    * @brief Submits the requests to a server to prepare and execute the unnamed
    * statement from the preparsed SQL string, and waits for a response.
@@ -773,13 +1078,15 @@ public:
    * Basic.
    *
    * @remarks See remarks of prepare_statement().
+   *
+   * @remarks If `(prepared_statement_cache_capacity() > 0)` the statement is
+   * obtained by using cached_prepared_statement() rather than prepared as the
+   * unnamed statement.
    */
   template<typename ... Types>
   void execute(const Sql_string* const statement, Types&& ... parameters)
   {
-    auto* const ps = prepare_statement(statement);
-    ps->set_parameters(std::forward<Types>(parameters)...);
-    ps->execute();
+    execute__(statement, std::forward<Types>(parameters)...);
   }
 
   /**
@@ -790,11 +1097,95 @@ public:
   template<typename ... Types>
   void execute(const std::string& statement, Types&& ... parameters)
   {
-    auto* const ps = prepare_statement(statement);
-    ps->set_parameters(std::forward<Types>(parameters)...);
-    ps->execute();
+    execute__(statement, std::forward<Types>(parameters)...);
   }
 
+  /**
+   * @brief Sets the maximum number of the prepared statements in the cache
+   * used by cached_prepared_statement() and execute().
+   *
+   * @param value - the value to set. The value of `0` disables the cache.
+   *
+   * @par Requires
+   * `(value >= prepared_statement_cache_size() || is_ready_for_request())`.
+   *
+   * @par Effects
+   * `(prepared_statement_cache_size() <= value)`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @remarks The capacity is not the property of the session, but the cache
+   * itself is. Thus, the cache is cleared upon disconnection.
+   *
+   * @remarks If the cache contains more than `value` statements, the least
+   * recently used statements are unprepared immediately.
+   */
+  virtual void set_prepared_statement_cache_capacity(std::size_t value) = 0;
+
+  /**
+   * @returns The maximum number of the prepared statements in the cache.
+   */
+  virtual std::size_t prepared_statement_cache_capacity() const noexcept = 0;
+
+  /**
+   * @returns The number of the prepared statements in the cache.
+   */
+  virtual std::size_t prepared_statement_cache_size() const noexcept = 0;
+
+  /**
+   * @returns The prepared statement from the cache associated with the
+   * `statement`.
+   *
+   * If there is no such a statement in the cache it's prepared as the named
+   * statement and cached. If the cache is full, the least recently used
+   * statement of the cache is unprepared before.
+   *
+   * @par Requires
+   * `(statement && !statement->has_missing_parameters() &&
+   *   prepared_statement_cache_capacity() > 0 && is_ready_for_request())`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @remarks The statements are cached by their textual representation. The
+   * names of the cached statements are generated automatically and must not
+   * be used to prepare other statements.
+   *
+   * @remarks Unpreparing of the cached statement by using unprepare_statement()
+   * removes it from the cache.
+   *
+   * @remarks The parameter and result formats of the returned statement are
+   * always set to parameter_format() and result_format() respectively.
+   */
+  virtual Prepared_statement* cached_prepared_statement(const Sql_string* statement) = 0;
+
+  /**
+   * @overload
+   *
+   * @remarks The statement will be send as-is without any preparsing.
+   */
+  virtual Prepared_statement* cached_prepared_statement(const std::string& statement) = 0;
+
+  /**
+   * @brief Sets the default preferred data format of the parameters of a next
+   * prepared statement.
+   *
+   * @param format - the data format to set.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see Prepared_statement::set_parameter_format().
+   */
+  virtual void set_parameter_format(Data_format format) = 0;
+
+  /**
+   * @returns The default preferred data format of the parameters of a next
+   * prepared statement.
+   */
+  virtual Data_format parameter_format() const noexcept = 0;
+
   /**
    * @brief Sets the default data format of the result for a next prepared
    * statement execution.
@@ -812,6 +1203,26 @@ public:
    */
   virtual Data_format result_format() const noexcept = 0;
 
+  /**
+   * @brief Sets the mode of delivering the rows for a next request.
+   *
+   * @param value - the mode to set.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The mode is applied to the requests submitted after the call,
+   * so it's possible to change it even when the responses are awaited.
+   *
+   * @see row_set().
+   */
+  virtual void set_row_processing(Row_processing value) = 0;
+
+  /**
+   * @returns The mode of delivering the rows for a next request.
+   */
+  virtual Row_processing row_processing() const noexcept = 0;
+
   ///@}
 
   // ---------------------------------------------------------------------------
@@ -825,17 +1236,25 @@ public:
    * @param body - the callback function.
    *
    * @par Requires
-   * `(bool(body) == true)`.
+   * `(bool(body) == true && row_set() == nullptr)`.
    *
    * @par Exception safety guarantee
    * Basic.
+   *
+   * @remarks The storage of each row is reused for the next one, so this is
+   * the most efficient way to process the rows.
+   *
+   * @remarks The rows are delivered one by one only if the request was
+   * submitted with `(row_processing() == Row_processing::single)`. The rows
+   * delivered as a Row_set must be processed by using row_set() instead.
    */
   virtual void for_each(const std::function<void(const Row*)>& body) = 0;
 
   /**
    * @overload
    *
-   * @remarks Calls body(release_row()).
+   * @remarks Calls body(release_row()). The memory of the released rows is
+   * recycled by the thread-local pool.
    */
   virtual void for_each(const std::function<void(std::unique_ptr<Row>&&)>& body) = 0;
 
@@ -933,12 +1352,23 @@ private:
   friend detail::iConnection;
 
   Connection() = default;
+
+  template<typename T, typename ... Types>
+  void execute__(T&& statement, Types&& ... parameters)
+  {
+    auto* const ps = prepared_statement_cache_capacity() > 0 ?
+      cached_prepared_statement(std::forward<T>(statement)) :
+      prepare_statement(std::forward<T>(statement));
+    ps->set_parameters(std::forward<Types>(parameters)...);
+    ps->execute();
+  }
 };
 
 } // namespace dmitigr::pgfe
 
 #ifdef DMITIGR_PGFE_HEADER_ONLY
 #include "dmitigr/pgfe/connection.cpp"
+#include "dmitigr/pgfe/copier_impl.cpp"
 #include "dmitigr/pgfe/prepared_statement_impl.cpp"
 #endif
 
@@ -0,0 +1,301 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "dmitigr/pgfe/basics.hpp"
+#include "dmitigr/pgfe/connection.hpp"
+#include "dmitigr/pgfe/connection_options.hpp"
+#include "dmitigr/pgfe/connection_pool.hpp"
+#include "dmitigr/pgfe/exceptions.hpp"
+#include "dmitigr/pgfe/implementation_header.hpp"
+
+#include <dmitigr/util/debug.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace dmitigr::pgfe::detail {
+
+/**
+ * @brief The implementation of Connection_pool.
+ */
+class iConnection_pool final : public Connection_pool {
+public:
+  /**
+   * @brief See Connection_pool::make().
+   */
+  iConnection_pool(const Connection_options* const options, const std::size_t max_size)
+    : state_{std::make_shared<State>(options, max_size)}
+  {
+    DMITIGR_ASSERT(state_->is_invariant_ok());
+  }
+
+  /** Non copyable. */
+  iConnection_pool(const iConnection_pool&) = delete;
+
+  /** Non copyable. */
+  iConnection_pool& operator=(const iConnection_pool&) = delete;
+
+  const Connection_options* options() const noexcept override
+  {
+    return state_->options.get();
+  }
+
+  std::size_t max_size() const noexcept override
+  {
+    return state_->max_size;
+  }
+
+  std::size_t size() const override
+  {
+    const std::lock_guard lg{state_->mutex};
+    return state_->size;
+  }
+
+  std::size_t idle_count() const override
+  {
+    const std::lock_guard lg{state_->mutex};
+    return state_->idle.size();
+  }
+
+  void set_idle_timeout(const std::optional<std::chrono::milliseconds> value) override
+  {
+    DMITIGR_REQUIRE(!value || value->count() >= 0, std::invalid_argument);
+    const std::lock_guard lg{state_->mutex};
+    state_->idle_timeout = value;
+  }
+
+  std::optional<std::chrono::milliseconds> idle_timeout() const override
+  {
+    const std::lock_guard lg{state_->mutex};
+    return state_->idle_timeout;
+  }
+
+  void set_max_lifetime(const std::optional<std::chrono::milliseconds> value) override
+  {
+    DMITIGR_REQUIRE(!value || value->count() >= 0, std::invalid_argument);
+    const std::lock_guard lg{state_->mutex};
+    state_->max_lifetime = value;
+  }
+
+  std::optional<std::chrono::milliseconds> max_lifetime() const override
+  {
+    const std::lock_guard lg{state_->mutex};
+    return state_->max_lifetime;
+  }
+
+  void set_statement_manifest(std::shared_ptr<const Statement_manifest> manifest) override
+  {
+    const std::lock_guard lg{state_->mutex};
+    state_->statement_manifest = std::move(manifest);
+  }
+
+  std::shared_ptr<const Statement_manifest> statement_manifest() const override
+  {
+    const std::lock_guard lg{state_->mutex};
+    return state_->statement_manifest;
+  }
+
+  std::shared_ptr<Connection> connection(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) override
+  {
+    using std::chrono::milliseconds;
+    using std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+
+    DMITIGR_REQUIRE(timeout >= milliseconds{-1}, std::invalid_argument);
+
+    const bool ignore_timeout = (timeout == milliseconds{-1});
+    const auto deadline = steady_clock::now() + (ignore_timeout ? milliseconds{} : timeout);
+
+    // The expired connections are closed after the mutex is unlocked.
+    std::vector<std::unique_ptr<Connection>> expired;
+    expired.reserve(state_->max_size); // so evict_expired() never throws
+    std::unique_ptr<Connection> result;
+    std::shared_ptr<const Statement_manifest> manifest;
+    {
+      std::unique_lock lock{state_->mutex};
+      while (true) {
+        state_->evict_expired(expired);
+
+        if (!state_->idle.empty()) {
+          // The most recently used connection is preferred (LIFO).
+          result = std::move(state_->idle.back().connection);
+          state_->idle.pop_back();
+          break;
+        } else if (state_->size < state_->max_size) {
+          manifest = state_->statement_manifest;
+          ++state_->size; // reserve the place for the new connection
+          break;
+        }
+
+        if (ignore_timeout)
+          state_->released.wait(lock);
+        else if (state_->released.wait_until(lock, deadline) == std::cv_status::timeout &&
+          state_->idle.empty() && state_->size == state_->max_size)
+          throw iClient_exception{Client_errc::timed_out, "connection pool timeout"};
+      }
+      DMITIGR_ASSERT(state_->is_invariant_ok());
+    }
+
+    if (!result) {
+      try {
+        result = Connection::make(state_->options.get()); // can throw
+        result->set_statement_manifest(std::move(manifest));
+        const auto remaining = ignore_timeout ? milliseconds{-1} :
+          std::max(milliseconds{}, duration_cast<milliseconds>(deadline - steady_clock::now()));
+        result->connect(remaining); // can throw
+      } catch (...) {
+        // rollback
+        const std::lock_guard lg{state_->mutex};
+        --state_->size;
+        state_->released.notify_one();
+        throw;
+      }
+    }
+
+    /*
+     * Note: the deleter is called if the constructor of std::shared_ptr throws,
+     * so the connection is returned back to the pool in this case.
+     */
+    return std::shared_ptr<Connection>(result.release(),
+      [state = std::weak_ptr<State>{state_}](Connection* const connection)
+      {
+        std::unique_ptr<Connection> guard{connection};
+        if (const auto s = state.lock())
+          s->release(std::move(guard));
+      });
+  }
+
+  void clear() override
+  {
+    std::vector<Idle_connection> idle;
+    {
+      const std::lock_guard lg{state_->mutex};
+      idle.reserve(state_->max_size); // can throw
+      idle.swap(state_->idle);
+      state_->size -= idle.size();
+      state_->released.notify_all();
+      DMITIGR_ASSERT(state_->is_invariant_ok());
+    }
+  }
+
+private:
+  struct Idle_connection final {
+    std::unique_ptr<Connection> connection;
+    std::chrono::steady_clock::time_point since;
+  };
+
+  /*
+   * The state of the pool which is shared with the deleters of the connections
+   * obtained from the pool. (Thus, the connections can outlive the pool.)
+   */
+  struct State final {
+    State(const Connection_options* const opts, const std::size_t msize)
+      : options{opts ? opts->to_connection_options() : Connection_options::make()}
+      , max_size{msize}
+    {
+      DMITIGR_REQUIRE(max_size > 0, std::invalid_argument);
+      idle.reserve(max_size); // so release() never allocates
+    }
+
+    bool is_invariant_ok() const
+    {
+      const bool size_ok = (size <= max_size);
+      const bool idle_ok = (idle.size() <= size) && (idle.capacity() >= max_size);
+      return size_ok && idle_ok;
+    }
+
+    /*
+     * @returns `true` if the idle connection `c` is expired according to the
+     * idle timeout and the maximum lifetime at the time point `now`, or if it
+     * doesn't pass the validation.
+     *
+     * @remarks Must be called with the mutex locked.
+     */
+    bool is_expired(const Idle_connection& c, const std::chrono::steady_clock::time_point now) const
+    {
+      return (idle_timeout && (now - c.since) >= *idle_timeout) ||
+        is_expired(*c.connection) || !c.connection->is_connected() ||
+        (c.connection->transaction_block_status() != Transaction_block_status::unstarted);
+    }
+
+    /*
+     * @returns `true` if the connection `c` is expired according to the
+     * maximum lifetime.
+     *
+     * @remarks Must be called with the mutex locked.
+     */
+    bool is_expired(const Connection& c) const
+    {
+      const auto start = c.session_start_time();
+      return max_lifetime && (!start || (std::chrono::system_clock::now() - *start) >= *max_lifetime);
+    }
+
+    /*
+     * Moves the expired idle connections to `out`.
+     *
+     * @remarks Must be called with the mutex locked.
+     */
+    void evict_expired(std::vector<std::unique_ptr<Connection>>& out)
+    {
+      const auto now = std::chrono::steady_clock::now();
+      const auto b = begin(idle);
+      const auto e = end(idle);
+      const auto i = std::stable_partition(b, e, [&](const auto& c) { return !is_expired(c, now); });
+      for (auto j = i; j != e; ++j)
+        out.push_back(std::move(j->connection)); // cannot throw if out.capacity() is enough
+      size -= (e - i);
+      idle.erase(i, e);
+    }
+
+    /*
+     * Returns the connection `c` back to the pool or closes it.
+     *
+     * Exception safety guarantee: nothrow.
+     */
+    void release(std::unique_ptr<Connection>&& c) noexcept
+    {
+      DMITIGR_ASSERT_NOTHROW(c);
+      c->dismiss_response();
+      const bool reusable = c->is_ready_for_request() && !c->is_pipeline_enabled() &&
+        (c->transaction_block_status() == Transaction_block_status::unstarted);
+
+      const std::lock_guard lg{mutex};
+      if (reusable && !is_expired(*c)) {
+        DMITIGR_ASSERT_NOTHROW(idle.size() < idle.capacity());
+        idle.push_back({std::move(c), std::chrono::steady_clock::now()}); // cannot throw
+      } else
+        --size;
+      released.notify_one();
+      DMITIGR_ASSERT_NOTHROW(is_invariant_ok());
+    } // Note: if `c` is not returned to the pool it's closed by the caller.
+
+    const std::unique_ptr<Connection_options> options;
+    const std::size_t max_size{};
+    mutable std::mutex mutex;
+    std::condition_variable released;
+    std::vector<Idle_connection> idle; // the last is the most recently used
+    std::size_t size{}; // the number of opened connections (including in use)
+    std::optional<std::chrono::milliseconds> idle_timeout;
+    std::optional<std::chrono::milliseconds> max_lifetime;
+    std::shared_ptr<const Statement_manifest> statement_manifest;
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+} // namespace dmitigr::pgfe::detail
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE std::unique_ptr<Connection_pool>
+Connection_pool::make(const Connection_options* const options, const std::size_t max_size)
+{
+  return std::make_unique<detail::iConnection_pool>(options, max_size);
+}
+
+} // namespace dmitigr::pgfe
+
+#include "dmitigr/pgfe/implementation_footer.hpp"
@@ -0,0 +1,192 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_CONNECTION_POOL_HPP
+#define DMITIGR_PGFE_CONNECTION_POOL_HPP
+
+#include "dmitigr/pgfe/dll.hpp"
+#include "dmitigr/pgfe/connection.hpp"
+#include "dmitigr/pgfe/types_fwd.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A thread-safe pool of connections to a PostgreSQL server.
+ *
+ * The pool opens the connections lazily (upon the request) and reuses them.
+ * The connection obtained from the pool is returned back to it automatically
+ * when the last copy of the obtained pointer is destroyed.
+ *
+ * @remarks The instance of this class can be safely used by multiple threads
+ * simultaneously. But each of the connections obtained from the pool must be
+ * used by one thread at a time.
+ */
+class Connection_pool {
+public:
+  /**
+   * @brief The destructor.
+   *
+   * @remarks The connections which are in use at the moment of the pool
+   * destruction are closed when their owners release them.
+   */
+  virtual ~Connection_pool() = default;
+
+  /// @name Constructors
+  /// @{
+
+  /**
+   * @returns A new instance of this class.
+   *
+   * @param options - the options of the connections of the pool. The value of
+   * `nullptr` means default connection options;
+   * @param max_size - the maximum number of the connections opened by the pool.
+   *
+   * @par Requires
+   * `(max_size > 0)`.
+   */
+  static DMITIGR_PGFE_API std::unique_ptr<Connection_pool> make(const Connection_options* options,
+    std::size_t max_size);
+
+  /// @}
+
+  /**
+   * @returns The options of the connections of the pool.
+   */
+  virtual const Connection_options* options() const noexcept = 0;
+
+  /**
+   * @returns The maximum number of the connections opened by the pool.
+   */
+  virtual std::size_t max_size() const noexcept = 0;
+
+  /**
+   * @returns The number of the connections currently opened by the pool
+   * (both idle and in use).
+   */
+  virtual std::size_t size() const = 0;
+
+  /**
+   * @returns The number of the connections currently opened by the pool
+   * which are not in use.
+   */
+  virtual std::size_t idle_count() const = 0;
+
+  /**
+   * @brief Sets the maximum amount of time the connection can be idle in the
+   * pool before it will be closed.
+   *
+   * @param value - the value of `std::nullopt` means *eternity*.
+   *
+   * @par Requires
+   * `(!value || value->count() >= 0)`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  virtual void set_idle_timeout(std::optional<std::chrono::milliseconds> value) = 0;
+
+  /**
+   * @returns The current value of the idle timeout.
+   */
+  virtual std::optional<std::chrono::milliseconds> idle_timeout() const = 0;
+
+  /**
+   * @brief Sets the maximum amount of time since the session start after
+   * which the connection will not be reused.
+   *
+   * @param value - the value of `std::nullopt` means *eternity*.
+   *
+   * @par Requires
+   * `(!value || value->count() >= 0)`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  virtual void set_max_lifetime(std::optional<std::chrono::milliseconds> value) = 0;
+
+  /**
+   * @returns The current value of the maximum lifetime of the connection.
+   */
+  virtual std::optional<std::chrono::milliseconds> max_lifetime() const = 0;
+
+  /**
+   * @brief Sets the statement manifest of the connections opened by the pool
+   * since now.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see to_statement_manifest(), Connection::set_statement_manifest().
+   */
+  virtual void set_statement_manifest(std::shared_ptr<const Statement_manifest> manifest) = 0;
+
+  /**
+   * @returns The current statement manifest.
+   */
+  virtual std::shared_ptr<const Statement_manifest> statement_manifest() const = 0;
+
+  /**
+   * @returns The connection ready for requests. The connection is returned
+   * back to the pool when the last copy of the returned pointer is destroyed.
+   *
+   * The idle connection is validated before it will be returned: it must be
+   * connected, its transaction block status must be
+   * Transaction_block_status::unstarted and it must not be expired according
+   * to idle_timeout() and max_lifetime(). The connection which doesn't pass
+   * the validation is closed, and the next one is tried (or the new one is
+   * opened).
+   *
+   * @param timeout - the maximum amount of time to wait for the connection
+   * if `(size() == max_size())` and all of the connections are in use. The
+   * value of `-1` means *eternity*.
+   *
+   * @par Requires
+   * `(timeout >= -1)`.
+   *
+   * @throws Client_exception with code of Client_errc::timed_out if no
+   * connection is released within the specified `timeout`, or if the
+   * connection establishment is not completed within the `timeout`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The connection which is not ready for requests, or which
+   * transaction block status is not Transaction_block_status::unstarted, or
+   * which is in the pipeline mode upon the return is closed rather than
+   * returned to the pool.
+   */
+  virtual std::shared_ptr<Connection> connection(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) = 0;
+
+  /**
+   * @brief Closes all of the idle connections of the pool.
+   *
+   * @par Effects
+   * `(idle_count() == 0)`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  virtual void clear() = 0;
+
+private:
+  friend detail::iConnection_pool;
+
+  Connection_pool() = default;
+};
+
+} // namespace dmitigr::pgfe
+
+#ifdef DMITIGR_PGFE_HEADER_ONLY
+#include "dmitigr/pgfe/connection_pool.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_CONNECTION_POOL_HPP
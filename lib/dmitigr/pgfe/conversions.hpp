@@ -12,15 +12,38 @@
 #include "dmitigr/pgfe/exceptions.hpp"
 #include "dmitigr/pgfe/types_fwd.hpp"
 
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <istream>
 #include <limits>
 #include <sstream>
+#include <streambuf>
 #include <string>
 #include <type_traits>
 #include <utility>
 
 namespace dmitigr::pgfe::detail {
 
+/**
+ * @brief The read-only stream buffer over the memory which is not owned.
+ */
+class Memory_istreambuf final : public std::streambuf {
+public:
+  /**
+   * @brief The constructor.
+   */
+  Memory_istreambuf(const char* const data, const std::size_t size)
+  {
+    // The get area is never written by std::streambuf.
+    char* const begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
 /**
  * @brief `T` to/from `std::string` conversions.
  */
@@ -29,10 +52,21 @@ struct Generic_string_conversions final {
   using Type = T;
 
   template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
+  static Type to_type(const std::string& text, Types&& ... args)
   {
+    return from_chars(text.data(), text.size(), std::forward<Types>(args)...);
+  }
+
+  /**
+   * @brief Similar to to_type() but reads the text directly from the memory.
+   */
+  template<typename ... Types>
+  static Type from_chars(const char* const text, const std::size_t size, Types&& ...)
+  {
+    DMITIGR_ASSERT(text);
     Type result;
-    std::istringstream stream{text};
+    Memory_istreambuf buffer{text, size};
+    std::istream stream{&buffer};
     stream >> result;
     if (!stream.eof())
       throw std::runtime_error("invalid text representation");
@@ -52,6 +86,9 @@ struct Generic_string_conversions final {
 
 /**
  * @brief `T` to/from Data conversions.
+ *
+ * @remarks If `StringConversions` provides `from_chars(text, size, args...)`
+ * then it's used to convert the data without making a temporary string.
  */
 template<typename T, class StringConversions>
 struct Generic_data_conversions final {
@@ -61,7 +98,10 @@ struct Generic_data_conversions final {
   static Type to_type(const Data* const data, Types&& ... args)
   {
     DMITIGR_REQUIRE(data, std::invalid_argument);
-    return StringConversions::to_type(std::string(data->bytes(), data->size()), std::forward<Types>(args)...);
+    if constexpr (Has_from_chars<StringConversions, Types...>::value)
+      return StringConversions::from_chars(data->bytes(), data->size(), std::forward<Types>(args)...);
+    else
+      return StringConversions::to_type(std::string(data->bytes(), data->size()), std::forward<Types>(args)...);
   }
 
   template<typename ... Types>
@@ -75,6 +115,17 @@ struct Generic_data_conversions final {
   {
     return Data::make(StringConversions::to_string(std::forward<U>(value), std::forward<Types>(args)...));
   }
+
+private:
+  template<class S, typename Void, typename ... Types>
+  struct Has_from_chars__ : std::false_type {};
+
+  template<class S, typename ... Types>
+  struct Has_from_chars__<S, std::void_t<decltype (S::from_chars(std::declval<const char*>(),
+    std::declval<std::size_t>(), std::declval<Types>()...))>, Types...> : std::true_type {};
+
+  template<class S, typename ... Types>
+  using Has_from_chars = Has_from_chars__<S, void, Types...>;
 };
 
 // -----------------------------------------------------------------------------
@@ -83,29 +134,120 @@ struct Generic_data_conversions final {
 
 /**
  * @brief The common implementation of numeric to/from `std::string` conversions.
+ *
+ * @remarks The conversions are locale-independent and performed by using
+ * `std::from_chars()` and `std::to_chars()` (if the standard library provides
+ * them for the floating point types, or `std::strto*()` and `std::to_string()`
+ * otherwise) without intermediate dynamic memory allocations.
  */
 template<typename T>
 struct Numeric_string_conversions_base {
   using Type = T;
 
   template<typename ... Types>
-  static std::string to_string(Type value, Types&& ...)
+  static Type to_type(const std::string& text, Types&& ...)
   {
-    return std::to_string(value);
+    return from_chars(text.data(), text.size());
   }
 
-protected:
-  template<typename Converter>
-  static Type to_numeric__(const std::string& text, Converter converter)
+  /**
+   * @brief Similar to to_type() but reads the text directly from the memory.
+   *
+   * @remarks Leading whitespaces and the plus sign are allowed just like the
+   * `std::sto*()` family allows them.
+   */
+  template<typename ... Types>
+  static Type from_chars(const char* const text, const std::size_t size, Types&& ...)
   {
-    Type result;
-    std::size_t idx;
-    result = converter(text, &idx);
-    if (idx != text.size())
+    DMITIGR_ASSERT(text);
+    const char* b = text;
+    const char* const e = text + size;
+    while (b != e && is_space__(*b))
+      ++b;
+    if (b != e && *b == '+' && (e - b == 1 || *(b + 1) != '-'))
+      ++b;
+
+    Type result{};
+    const auto [ptr, ec] = from_chars__(b, e, result);
+    if (ec == std::errc::invalid_argument)
+      throw std::invalid_argument{"the input string is not convertible to numeric"};
+    else if (ec == std::errc::result_out_of_range)
+      throw std::out_of_range{"the numeric value is out of range"};
+    else if (ptr != e)
       throw std::runtime_error{"the input string contains symbols not convertible to numeric"};
 
     return result;
   }
+
+  template<typename ... Types>
+  static std::string to_string(const Type value, Types&& ...)
+  {
+    if constexpr (std::is_integral_v<Type> || Is_to_chars_float_supported) {
+      char buffer[Max_chars];
+      const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+      DMITIGR_ASSERT(ec == std::errc{});
+      return std::string(buffer, ptr);
+    } else
+      return std::to_string(value);
+  }
+
+private:
+#ifdef __cpp_lib_to_chars
+  static constexpr bool Is_to_chars_float_supported = true;
+#else
+  static constexpr bool Is_to_chars_float_supported = false;
+#endif
+
+  /*
+   * The maximum length of the text representation of the value: the digits,
+   * the sign, the decimal point and the exponent (for the shortest round-trip
+   * representation of the floating point value).
+   */
+  static constexpr std::size_t Max_chars = std::is_integral_v<Type> ?
+    std::numeric_limits<Type>::digits10 + 3 : std::numeric_limits<Type>::max_digits10 + 16;
+
+  static bool is_space__(const char c) noexcept
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+  }
+
+  static std::from_chars_result from_chars__(const char* const b, const char* const e, Type& result)
+  {
+    if constexpr (std::is_integral_v<Type> || Is_to_chars_float_supported) {
+      return std::from_chars(b, e, result);
+    } else {
+      // std::strto*() requires the null-terminated string.
+      constexpr std::size_t buffer_size = 64;
+      const auto size = static_cast<std::size_t>(e - b);
+      char local[buffer_size];
+      std::string heap;
+      const char* str{};
+      if (size < buffer_size) {
+        std::memcpy(local, b, size);
+        local[size] = '\0';
+        str = local;
+      } else {
+        heap.assign(b, size);
+        str = heap.c_str();
+      }
+
+      char* end{};
+      errno = 0;
+      if constexpr (std::is_same_v<Type, float>)
+        result = std::strtof(str, &end);
+      else if constexpr (std::is_same_v<Type, double>)
+        result = std::strtod(str, &end);
+      else
+        result = std::strtold(str, &end);
+
+      std::from_chars_result r{b + (end - str), std::errc{}};
+      if (end == str || std::isspace(static_cast<unsigned char>(*str)))
+        r = {b, std::errc::invalid_argument};
+      else if (errno == ERANGE)
+        r.ec = std::errc::result_out_of_range;
+      return r;
+    }
+  }
 };
 
 // -----------------------------------------------------------------------------
@@ -115,116 +257,49 @@ protected:
  */
 template<>
 struct Numeric_string_conversions<short int> final
-  : private Numeric_string_conversions_base<int> {
-  using Type = short int;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    const int result = to_numeric__(text, [](auto text, auto* idx) { return std::stoi(text, idx); });
-    constexpr auto max = std::numeric_limits<short int>::max();
-    if (result > max)
-      throw std::runtime_error("numeric value " + text + " > " + std::to_string(max));
-    return Type(result);
-  }
-};
+  : public Numeric_string_conversions_base<short int> {};
 
 /**
  * @brief The implementation of `int` to/from `std::string` conversions.
  */
 template<>
 struct Numeric_string_conversions<int> final
-  : private Numeric_string_conversions_base<int> {
-  using Type = int;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, [](auto text, auto* idx) { return std::stoi(text, idx); });
-  }
-};
+  : public Numeric_string_conversions_base<int> {};
 
 /**
  * @brief The implementation of `long int` to/from `std::string` conversions.
  */
 template<>
 struct Numeric_string_conversions<long int> final
-  : private Numeric_string_conversions_base<long int> {
-  using Type = long int;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, [](auto text, auto* idx) { return std::stol(text, idx); });
-  }
-};
+  : public Numeric_string_conversions_base<long int> {};
 
 /**
  * @brief The implementation of `long long int` to/from `std::string` conversions.
  */
 template<>
 struct Numeric_string_conversions<long long int> final
-  : private Numeric_string_conversions_base<long long int> {
-  using Type = long long int;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, [](auto text, auto* idx) { return std::stoll(text, idx); });
-  }
-};
+  : public Numeric_string_conversions_base<long long int> {};
 
 /**
  * @brief The implementation of `float` to/from `std::string` conversions.
  */
 template<>
 struct Numeric_string_conversions<float> final
-  : private Numeric_string_conversions_base<float> {
-  using Type = float;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, [](auto text, auto* idx) { return std::stof(text, idx); });
-  }
-};
+  : public Numeric_string_conversions_base<float> {};
 
 /**
  * @brief The implementation of `double` to/from `std::string` conversions.
  */
 template<>
 struct Numeric_string_conversions<double> final
-  : private Numeric_string_conversions_base<double> {
-  using Type = double;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, [](auto text, auto* idx) { return std::stod(text, idx); });
-  }
-};
+  : public Numeric_string_conversions_base<double> {};
 
 /**
  * @brief The implementation of `long double` to/from `std::string` conversions.
  */
 template<>
 struct Numeric_string_conversions<long double> final
-  : private Numeric_string_conversions_base<long double> {
-  using Type = long double;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, [](auto text, auto* idx) { return std::stold(text, idx); });
-  }
-};
+  : public Numeric_string_conversions_base<long double> {};
 
 // -----------------------------------------------------------------------------
 // Optimized numeric to/from Data conversions
@@ -279,7 +354,41 @@ struct Numeric_data_conversions final {
     return Generic_data_conversions<Type, StringConversions>::to_data(value, std::forward<Types>(args)...);
   }
 
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type value, const Data_format format, Types&& ... args)
+  {
+    if (format == Data_format::binary)
+      return to_binary_data__(value);
+    else
+      return to_data(value, std::forward<Types>(args)...);
+  }
+
 private:
+  // Encodes the value in the network byte order like the server's send function does.
+  static std::unique_ptr<Data> to_binary_data__(const Type value)
+  {
+    if constexpr (std::is_integral_v<Type> && (sizeof(Type) == 2 || sizeof(Type) == 4 || sizeof(Type) == 8)) {
+      return to_big_endian_data__(static_cast<std::make_unsigned_t<Type>>(value));
+    } else if constexpr (std::is_same_v<Type, float> || std::is_same_v<Type, double>) {
+      static_assert(std::numeric_limits<Type>::is_iec559);
+      using Bits = std::conditional_t<std::is_same_v<Type, float>, std::uint32_t, std::uint64_t>;
+      static_assert(sizeof(Bits) == sizeof(Type));
+      Bits bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return to_big_endian_data__(bits);
+    } else
+      throw std::logic_error("binary format is not supported for this numeric type");
+  }
+
+  template<typename U>
+  static std::unique_ptr<Data> to_big_endian_data__(const U value)
+  {
+    std::string result(sizeof(U), '\0');
+    for (std::size_t i = 0; i < sizeof(U); ++i)
+      result[i] = static_cast<char>((value >> ((sizeof(U) - 1 - i) * 8)) & 0xff);
+    return Data::make(std::move(result), Data_format::binary);
+  }
+
   enum class Endianness {
     unknown = 0,
     big,
@@ -446,6 +555,15 @@ struct Bool_data_conversions final {
   {
     return Data::make(Bool_string_conversions::to_string(value));
   }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type value, const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::binary)
+      return Data::make(std::string(1, value ? '\1' : '\0'), Data_format::binary);
+    else
+      return to_data(value);
+  }
 };
 
 } // namespace dmitigr::pgfe::detail
@@ -459,7 +577,13 @@ namespace dmitigr::pgfe {
  *
  * The support of the following data formats is implemented:
  *   - for input data  - Data_format::text, Data_format::binary;
- *   - for output data - Data_format::text.
+ *   - for output data - Data_format::text, Data_format::binary (except
+ *   `long double`, which has no binary representation on the server side).
+ *
+ * The output data in Data_format::binary format is produced by
+ * `to_data(value, Data_format::binary)` in the network byte order, i.e. in
+ * the form which is expected by the `int2`, `int4`, `int8`, `float4` and
+ * `float8` types.
  *
  * @par Requires
  * When converting to the native type `Type`, the size of the input data in
@@ -573,7 +697,8 @@ struct Conversions<char> final : public Basic_conversions<char,
  *
  * The support of the following data formats is implemented:
  *   - for input data  - Data_format::text, Data_format::binary;
- *   - for output data - Data_format::text.
+ *   - for output data - Data_format::text, Data_format::binary (by using
+ *   `to_data(value, Data_format::binary)`).
  *
  * @par Requires
  * The size of the input data in the Data_format::binary format must be
@@ -583,6 +708,37 @@ template<>
 struct Conversions<bool> final : public Basic_conversions<bool,
   detail::Bool_string_conversions, detail::Bool_data_conversions>{};
 
+// -----------------------------------------------------------------------------
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Indicates whether the Conversions of `T` can produce the Data in the
+ * Data_format::binary format by using `to_data(value, Data_format::binary)`.
+ *
+ * @see Prepared_statement::set_parameter_format().
+ */
+template<typename T>
+struct Is_binary_data_convertible : std::false_type {};
+
+/// @cond
+template<> struct Is_binary_data_convertible<short int> : std::true_type {};
+template<> struct Is_binary_data_convertible<int> : std::true_type {};
+template<> struct Is_binary_data_convertible<long int> : std::true_type {};
+template<> struct Is_binary_data_convertible<long long int> : std::true_type {};
+template<> struct Is_binary_data_convertible<float> : std::true_type {};
+template<> struct Is_binary_data_convertible<double> : std::true_type {};
+template<> struct Is_binary_data_convertible<bool> : std::true_type {};
+/// @endcond
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The helper variable template.
+ */
+template<typename T>
+constexpr bool Is_binary_data_convertible_v = Is_binary_data_convertible<T>::value;
+
 } // namespace dmitigr::pgfe
 
 #endif  // DMITIGR_PGFE_CONVERSIONS_HPP
@@ -0,0 +1,214 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_COPIER_HPP
+#define DMITIGR_PGFE_COPIER_HPP
+
+#include "dmitigr/pgfe/basics.hpp"
+#include "dmitigr/pgfe/conversions.hpp"
+#include "dmitigr/pgfe/data.hpp"
+#include "dmitigr/pgfe/response.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A data copier of the `COPY FROM STDIN` and `COPY TO STDOUT` commands.
+ *
+ * The copier is the response to the query which starts the `COPY` operation.
+ * Once the copier is available the connection is in the *copy state*, and
+ * the data must be transferred in the direction denoted by data_direction():
+ *   - if `(data_direction() == Data_direction::to_server)`, the data must be
+ *     sent by using send() or send_row() and the operation must be finished
+ *     by using end();
+ *   - if `(data_direction() == Data_direction::from_server)`, the data must be
+ *     received by using receive() until it returns `nullptr`.
+ *
+ * Upon finishing of the operation the copier is dismissed and the Completion
+ * or the Error must be awaited by using Connection::wait_response().
+ *
+ * @par Example
+ * @code
+ * conn->perform("COPY person (id, name) FROM STDIN");
+ * auto* const copier = conn->copier();
+ * copier->send_row(1, "Dmitry");
+ * copier->send_row(2, nullptr);
+ * copier->end();
+ * conn->wait_response_throw(); // the Completion with the tag "COPY 2"
+ * @endcode
+ *
+ * @see Connection::copier().
+ */
+class Copier : public Response {
+public:
+  /**
+   * @returns The direction of the data transfer.
+   */
+  virtual Data_direction data_direction() const noexcept = 0;
+
+  /**
+   * @returns The overall format of the data to transfer.
+   */
+  virtual Data_format data_format() const noexcept = 0;
+
+  /**
+   * @returns The number of the fields (columns) of the data to transfer.
+   */
+  virtual std::size_t field_count() const noexcept = 0;
+
+  /**
+   * @returns The format of the field (column) of the data to transfer.
+   *
+   * @par Requires
+   * `(index < field_count())`.
+   */
+  virtual Data_format data_format(std::size_t index) const = 0;
+
+  /**
+   * @returns `true` if the data transfer is not yet finished.
+   */
+  virtual bool is_active() const noexcept = 0;
+
+  /**
+   * @brief Sends the chunk of data to the server.
+   *
+   * The `data` must be in the format which is expected by the `COPY` command.
+   * The chunk is not required to contain the whole rows.
+   *
+   * @par Requires
+   * `(is_active() && data_direction() == Data_direction::to_server)`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  virtual void send(std::string_view data) = 0;
+
+  /**
+   * @brief Encodes and sends the row.
+   *
+   * Each of `values` may be:
+   *   - `nullptr` to represent the SQL NULL;
+   *   - a pointer to the Data (`nullptr` represents the SQL NULL);
+   *   - `std::unique_ptr<Data>`;
+   *   - a C-string (which is treated as the data in the text format);
+   *   - any other value which is converted to the Data by using to_data().
+   *
+   * The row is encoded according to data_format(): in case of the text format
+   * the special characters of the data are escaped; in case of the binary
+   * format the header of the binary `COPY` format is sent automatically before
+   * the first row (or by end() if no rows were sent), and the trailer is sent
+   * by end().
+   *
+   * @par Requires
+   * `(is_active() && data_direction() == Data_direction::to_server &&
+   * sizeof ... (values) == field_count())`. The formats of the data of the
+   * values must be equal to data_format().
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @remarks The buffer for encoding is reused by this copier, so there is no
+   * memory allocation per row except the conversion of `values` to the Data.
+   */
+  template<typename ... Types>
+  void send_row(Types&& ... values)
+  {
+    static_assert(sizeof ... (Types) > 0, "row must contain at least one field");
+    send_row__(std::make_index_sequence<sizeof ... (Types)>{}, std::forward<Types>(values)...);
+  }
+
+  /**
+   * @brief Similar to send_row() but accepts the data of the fields as array.
+   *
+   * @param fields - the array of the data of the fields. The value of `nullptr`
+   * represents the SQL NULL;
+   * @param count - the number of elements of `fields`.
+   *
+   * @par Requires
+   * `(is_active() && data_direction() == Data_direction::to_server &&
+   * fields && count == field_count())`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  virtual void send_row_data(const Data* const* fields, std::size_t count) = 0;
+
+  /**
+   * @brief Finishes the sending of the data to the server.
+   *
+   * @param error_message - if not empty, the `COPY` command is forced to fail
+   * with the specified message.
+   *
+   * @par Requires
+   * `(is_active() && data_direction() == Data_direction::to_server)`.
+   *
+   * @par Effects
+   * `!is_active()`. The copier is dismissed by the connection.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  virtual void end(const std::string& error_message = {}) = 0;
+
+  /**
+   * @returns The next chunk of data received from the server, or `nullptr`
+   * if the data transfer is finished. In case of the text format each chunk
+   * is exactly one row (including the terminating newline).
+   *
+   * @par Requires
+   * `(data_direction() == Data_direction::from_server)`.
+   *
+   * @par Effects
+   * If `nullptr` is returned then `!is_active()` and the copier is dismissed
+   * by the connection.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  virtual std::unique_ptr<Data> receive() = 0;
+
+private:
+  friend detail::iCopier;
+
+  Copier() = default;
+
+  template<std::size_t ... I, typename ... Types>
+  void send_row__(std::index_sequence<I...>, Types&& ... values)
+  {
+    std::unique_ptr<Data> storage[sizeof ... (Types)];
+    const Data* const fields[] = {to_field__(storage[I], std::forward<Types>(values))...};
+    send_row_data(fields, sizeof ... (Types));
+  }
+
+  template<typename T>
+  static const Data* to_field__(std::unique_ptr<Data>& storage, T&& value)
+  {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, std::nullptr_t>) {
+      return nullptr;
+    } else if constexpr (std::is_convertible_v<U, const Data*>) {
+      return value;
+    } else if constexpr (std::is_same_v<U, std::unique_ptr<Data>>) {
+      return value.get();
+    } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+      storage = Data::make(value);
+      return storage.get();
+    } else {
+      storage = to_data(std::forward<T>(value));
+      return storage.get();
+    }
+  }
+};
+
+} // namespace dmitigr::pgfe
+
+#endif  // DMITIGR_PGFE_COPIER_HPP
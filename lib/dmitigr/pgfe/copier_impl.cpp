@@ -0,0 +1,171 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "dmitigr/pgfe/connection.hpp"
+#include "dmitigr/pgfe/copier_impl.hpp"
+#include "dmitigr/pgfe/implementation_header.hpp"
+
+#include <cstdint>
+#include <limits>
+
+namespace dmitigr::pgfe::detail {
+
+inline void pq_Copier::send(const std::string_view data)
+{
+  DMITIGR_REQUIRE(is_active() && data_direction() == Data_direction::to_server, std::logic_error);
+  DMITIGR_REQUIRE(data.size() <= static_cast<std::size_t>(std::numeric_limits<int>::max()), std::invalid_argument);
+
+  // Note: the connection is in the blocking mode, so ::PQputCopyData() never returns 0.
+  if (::PQputCopyData(connection_->conn_, data.data(), static_cast<int>(data.size())) != 1)
+    throw std::runtime_error(connection_->error_message());
+}
+
+inline void pq_Copier::send_row_data(const Data* const* const fields, const std::size_t count)
+{
+  DMITIGR_REQUIRE(is_active() && data_direction() == Data_direction::to_server, std::logic_error);
+  DMITIGR_REQUIRE(fields && count == field_count(), std::invalid_argument);
+
+  const auto format = data_format();
+  auto& buf = row_buffer_;
+  buf.clear(); // the capacity is retained
+  if (format == Data_format::text) {
+    // See "File Formats" section of https://www.postgresql.org/docs/current/sql-copy.html
+    for (std::size_t i = 0; i < count; ++i) {
+      if (i > 0)
+        buf.push_back('\t');
+
+      if (const auto* const f = fields[i]) {
+        DMITIGR_REQUIRE(f->format() == Data_format::text, std::invalid_argument);
+        const char* const bytes = f->bytes();
+        const auto size = f->size();
+        for (std::size_t j = 0; j < size; ++j) {
+          const char c = bytes[j];
+          switch (c) {
+          case '\\': buf.append("\\\\", 2); break;
+          case '\t': buf.append("\\t", 2); break;
+          case '\n': buf.append("\\n", 2); break;
+          case '\r': buf.append("\\r", 2); break;
+          default: buf.push_back(c);
+          }
+        }
+      } else
+        buf.append("\\N", 2);
+    }
+    buf.push_back('\n');
+  } else {
+    const auto append_int = [&buf](const auto value)
+    {
+      using U = std::make_unsigned_t<std::decay_t<decltype (value)>>;
+      const auto v = static_cast<U>(value);
+      for (int i = static_cast<int>(sizeof(U)) - 1; i >= 0; --i)
+        buf.push_back(static_cast<char>((v >> (i * 8)) & 0xff));
+    };
+
+    if (!is_binary_header_sent_)
+      append_binary_header();
+
+    DMITIGR_REQUIRE(count <= static_cast<std::size_t>(std::numeric_limits<std::int16_t>::max()), std::invalid_argument);
+    append_int(static_cast<std::int16_t>(count));
+    for (std::size_t i = 0; i < count; ++i) {
+      if (const auto* const f = fields[i]) {
+        DMITIGR_REQUIRE(f->format() == Data_format::binary, std::invalid_argument);
+        DMITIGR_REQUIRE(f->size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()),
+          std::invalid_argument);
+        append_int(static_cast<std::int32_t>(f->size()));
+        buf.append(f->bytes(), f->size());
+      } else
+        append_int(std::int32_t{-1});
+    }
+  }
+
+  try {
+    send(buf); // can throw
+  } catch (...) {
+    buf.clear();
+    throw;
+  }
+  buf.clear();
+  if (format == Data_format::binary)
+    is_binary_header_sent_ = true;
+
+  DMITIGR_ASSERT(is_invariant_ok());
+}
+
+inline void pq_Copier::end(const std::string& error_message)
+{
+  DMITIGR_REQUIRE(is_active() && data_direction() == Data_direction::to_server, std::logic_error);
+
+  if (data_format() == Data_format::binary && error_message.empty()) {
+    // The header must be sent even if there are no rows.
+    auto& buf = row_buffer_;
+    buf.clear();
+    if (!is_binary_header_sent_)
+      append_binary_header();
+    buf.append("\377\377", 2); // the file trailer
+    try {
+      send(buf); // can throw
+    } catch (...) {
+      buf.clear();
+      throw;
+    }
+    buf.clear();
+    is_binary_header_sent_ = true;
+  }
+
+  const char* const errmsg = !error_message.empty() ? error_message.c_str() : nullptr;
+  if (::PQputCopyEnd(connection_->conn_, errmsg) != 1)
+    throw std::runtime_error(connection_->error_message());
+
+  deactivate();
+
+  DMITIGR_ASSERT(is_invariant_ok());
+}
+
+inline std::unique_ptr<Data> pq_Copier::receive()
+{
+  DMITIGR_REQUIRE(data_direction() == Data_direction::from_server, std::logic_error);
+
+  if (!is_active())
+    return nullptr;
+
+  while (true) {
+    char* buffer{};
+    constexpr int async{1};
+    const int size = ::PQgetCopyData(connection_->conn_, &buffer, async);
+    if (size > 0) {
+      using Uptr = std::unique_ptr<void, void(*)(void*)>;
+      // Note: the buffer is always null-terminated.
+      return Data::make(Uptr{buffer, &::PQfreemem}, static_cast<std::size_t>(size), data_format());
+    } else if (size == 0) {
+      // The row is not yet available.
+      connection_->wait_socket_readiness(Socket_readiness::read_ready, std::chrono::milliseconds{-1});
+      if (!::PQconsumeInput(connection_->conn_))
+        throw std::runtime_error(connection_->error_message());
+    } else if (size == -1) {
+      // The end of the data (the result of the COPY command is available).
+      deactivate();
+      return nullptr;
+    } else
+      throw std::runtime_error(connection_->error_message());
+  }
+}
+
+inline void pq_Copier::append_binary_header()
+{
+  // The signature, the flags field and the header extension area length.
+  constexpr char signature[] = "PGCOPY\n\377\r\n";
+  row_buffer_.append(signature, sizeof(signature)); // including the trailing zero byte
+  row_buffer_.append(8, '\0');
+}
+
+inline void pq_Copier::deactivate() noexcept
+{
+  is_active_ = false;
+  if (connection_->copier() == this)
+    connection_->dismiss_response();
+}
+
+} // namespace dmitigr::pgfe::detail
+
+#include "dmitigr/pgfe/implementation_footer.hpp"
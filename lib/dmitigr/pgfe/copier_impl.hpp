@@ -0,0 +1,117 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_COPIER_IMPL_HPP
+#define DMITIGR_PGFE_COPIER_IMPL_HPP
+
+#include "dmitigr/pgfe/copier.hpp"
+#include "dmitigr/pgfe/pq.hpp"
+
+#include <dmitigr/util/debug.hpp>
+
+#include <string>
+
+namespace dmitigr::pgfe::detail {
+
+/**
+ * @brief The base implementation of Copier.
+ */
+class iCopier : public Copier {
+protected:
+  virtual bool is_invariant_ok() const = 0;
+};
+
+inline bool iCopier::is_invariant_ok() const
+{
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+class pq_Connection;
+
+/**
+ * @brief The implementation of Copier based on libpq.
+ */
+class pq_Copier final : public iCopier {
+public:
+  /**
+   * @brief The constructor.
+   *
+   * @par Requires
+   * `(connection && (r.status() == PGRES_COPY_IN || r.status() == PGRES_COPY_OUT))`.
+   */
+  pq_Copier(pq_Connection* const connection, pq::Result&& r)
+    : connection_{connection}
+    , pq_result_{std::move(r)}
+  {
+    DMITIGR_ASSERT(connection_);
+    DMITIGR_ASSERT(pq_result_.status() == PGRES_COPY_IN || pq_result_.status() == PGRES_COPY_OUT);
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  /** Non copyable. */
+  pq_Copier(const pq_Copier&) = delete;
+
+  /** Non copyable. */
+  pq_Copier& operator=(const pq_Copier&) = delete;
+
+  Data_direction data_direction() const noexcept override
+  {
+    return (pq_result_.status() == PGRES_COPY_IN) ? Data_direction::to_server : Data_direction::from_server;
+  }
+
+  Data_format data_format() const noexcept override
+  {
+    return pq::to_data_format(::PQbinaryTuples(pq_result_.pg_result()));
+  }
+
+  std::size_t field_count() const noexcept override
+  {
+    return static_cast<std::size_t>(pq_result_.field_count());
+  }
+
+  Data_format data_format(const std::size_t index) const override
+  {
+    DMITIGR_REQUIRE(index < field_count(), std::out_of_range);
+    return pq_result_.field_format(static_cast<int>(index));
+  }
+
+  bool is_active() const noexcept override
+  {
+    return is_active_;
+  }
+
+  void send(std::string_view data) override;
+
+  void send_row_data(const Data* const* fields, std::size_t count) override;
+
+  void end(const std::string& error_message = {}) override;
+
+  std::unique_ptr<Data> receive() override;
+
+private:
+  bool is_invariant_ok() const override
+  {
+    const bool header_ok = !is_binary_header_sent_ || data_direction() == Data_direction::to_server;
+    const bool icopier_ok = iCopier::is_invariant_ok();
+    return header_ok && icopier_ok;
+  }
+
+  // Appends the header of the binary format to the row_buffer_.
+  void append_binary_header();
+
+  // Marks the copier as inactive and dismisses it by the connection.
+  void deactivate() noexcept;
+
+  pq_Connection* connection_{};
+  pq::Result pq_result_;
+  bool is_active_{true};
+  bool is_binary_header_sent_{};
+  std::string row_buffer_; // reused by send_row_data() and end()
+};
+
+} // namespace dmitigr::pgfe::detail
+
+#endif  // DMITIGR_PGFE_COPIER_IMPL_HPP
@@ -0,0 +1,504 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_COROUTINES_HPP
+#define DMITIGR_PGFE_COROUTINES_HPP
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "dmitigr/pgfe/coroutines.hpp requires the C++20 coroutines support"
+#endif
+
+#include "dmitigr/pgfe/basics.hpp"
+#include "dmitigr/pgfe/connection.hpp"
+#include "dmitigr/pgfe/prepared_statement_dfn.hpp"
+#include "dmitigr/pgfe/reactor.hpp"
+#include "dmitigr/pgfe/row.hpp"
+
+#include <dmitigr/util/debug.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace dmitigr::pgfe {
+
+template<typename T = void> class Task;
+
+namespace detail {
+
+/**
+ * @brief The common part of the promise types of Task.
+ */
+class Task_promise_base {
+public:
+  std::suspend_always initial_suspend() const noexcept
+  {
+    return {};
+  }
+
+  /**
+   * @brief The awaiter which transfers the control to the awaiting coroutine.
+   */
+  struct Final_awaiter final {
+    bool await_ready() const noexcept
+    {
+      return false;
+    }
+
+    template<class Promise>
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<Promise> handle) const noexcept
+    {
+      const auto continuation = handle.promise().continuation_;
+      return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept
+    {}
+  };
+
+  Final_awaiter final_suspend() const noexcept
+  {
+    return {};
+  }
+
+  void unhandled_exception() noexcept
+  {
+    exception_ = std::current_exception();
+  }
+
+  void set_continuation(const std::coroutine_handle<> continuation) noexcept
+  {
+    continuation_ = continuation;
+  }
+
+protected:
+  void rethrow_if_exception() const
+  {
+    if (exception_)
+      std::rethrow_exception(exception_);
+  }
+
+private:
+  std::coroutine_handle<> continuation_;
+  std::exception_ptr exception_;
+};
+
+/**
+ * @brief The promise type of Task.
+ */
+template<typename T>
+class Task_promise final : public Task_promise_base {
+public:
+  Task<T> get_return_object() noexcept;
+
+  template<typename U>
+  void return_value(U&& value)
+  {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T result()
+  {
+    rethrow_if_exception();
+    DMITIGR_ASSERT(value_);
+    return std::move(*value_);
+  }
+
+private:
+  std::optional<T> value_;
+};
+
+/**
+ * @brief The full specialization of Task_promise for `void`.
+ */
+template<>
+class Task_promise<void> final : public Task_promise_base {
+public:
+  Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept
+  {}
+
+  void result() const
+  {
+    rethrow_if_exception();
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup main
+ *
+ * @brief A lazily started coroutine which produces the value of type `T`.
+ *
+ * The coroutine is started when the task is awaited (`co_await std::move(task)`)
+ * by another coroutine, or when the task is passed to spawn().
+ */
+template<typename T>
+class [[nodiscard]] Task final {
+public:
+  /**
+   * @brief The alias of the promise type.
+   */
+  using promise_type = detail::Task_promise<T>;
+
+  /**
+   * @brief The destructor.
+   */
+  ~Task()
+  {
+    if (handle_)
+      handle_.destroy();
+  }
+
+  /** Non copyable. */
+  Task(const Task&) = delete;
+
+  /** Non copyable. */
+  Task& operator=(const Task&) = delete;
+
+  /**
+   * @brief The move constructor.
+   */
+  Task(Task&& rhs) noexcept
+    : handle_{std::exchange(rhs.handle_, {})}
+  {}
+
+  /**
+   * @brief The move assignment operator.
+   */
+  Task& operator=(Task&& rhs) noexcept
+  {
+    if (this != &rhs) {
+      Task tmp{std::move(rhs)};
+      std::swap(handle_, tmp.handle_);
+    }
+    return *this;
+  }
+
+  /**
+   * @returns The awaiter which starts the coroutine and suspends the awaiting
+   * coroutine until the result is available.
+   *
+   * @par Requires
+   * The task must not be awaited before.
+   */
+  auto operator co_await() && noexcept
+  {
+    struct Awaiter final {
+      std::coroutine_handle<promise_type> handle;
+
+      bool await_ready() const noexcept
+      {
+        return handle.done();
+      }
+
+      std::coroutine_handle<> await_suspend(const std::coroutine_handle<> continuation) const noexcept
+      {
+        handle.promise().set_continuation(continuation);
+        return handle;
+      }
+
+      T await_resume() const
+      {
+        return handle.promise().result();
+      }
+    };
+
+    DMITIGR_ASSERT_NOTHROW(handle_);
+    return Awaiter{handle_};
+  }
+
+private:
+  friend promise_type;
+
+  explicit Task(const std::coroutine_handle<promise_type> handle) noexcept
+    : handle_{handle}
+  {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template<typename T>
+inline Task<T> Task_promise<T>::get_return_object() noexcept
+{
+  return Task<T>{std::coroutine_handle<Task_promise>::from_promise(*this)};
+}
+
+inline Task<void> Task_promise<void>::get_return_object() noexcept
+{
+  return Task<void>{std::coroutine_handle<Task_promise>::from_promise(*this)};
+}
+
+/**
+ * @brief The eagerly started coroutine which destroys itself upon completion.
+ */
+struct Spawned_task final {
+  struct promise_type final {
+    Spawned_task get_return_object() const noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never initial_suspend() const noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never final_suspend() const noexcept
+    {
+      return {};
+    }
+
+    void return_void() const noexcept
+    {}
+
+    [[noreturn]] void unhandled_exception() const noexcept
+    {
+      std::terminate();
+    }
+  };
+};
+
+inline Spawned_task spawn__(Task<void> task, const std::function<void(std::exception_ptr)> error_handler)
+{
+  std::exception_ptr exception;
+  try {
+    co_await std::move(task);
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  if (exception) {
+    if (error_handler)
+      error_handler(exception);
+    else
+      std::rethrow_exception(exception); // std::terminate() will be called
+  }
+}
+
+} // namespace detail
+
+/**
+ * @ingroup main
+ *
+ * @brief Starts the task and detaches it.
+ *
+ * The task runs until its first suspension point (for example, until the
+ * response is awaited) and then is resumed by the event loop.
+ *
+ * @param error_handler - the handler of the exception thrown by the task. If
+ * not set then `std::terminate()` is called in such a case.
+ */
+inline void spawn(Task<void> task, std::function<void(std::exception_ptr)> error_handler = {})
+{
+  detail::spawn__(std::move(task), std::move(error_handler));
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @ingroup main
+ *
+ * @brief The connection adapter which provides the awaitable operations.
+ *
+ * The awaiting coroutine is resumed by the event loop `EventLoop`, which
+ * must provide the following member functions (Reactor does):
+ * @code
+ * void connect(Connection* connection, Handler handler);
+ * void await_response(Connection* connection, Handler handler);
+ * @endcode
+ * where `Handler` is constructible from the function object which accepts the
+ * `Connection*` argument. The handler must be called once upon completion of
+ * the operation, and must not be called from within the functions above.
+ *
+ * @par Example
+ * @code
+ * pgfe::Task<> handle(pgfe::Async_connection<>& conn)
+ * {
+ *   co_await conn.connect();
+ *   co_await conn.execute("SELECT generate_series(1, $1)", 3);
+ *   while (const auto row = co_await conn.next_row())
+ *     std::cout << pgfe::to<int>(row->data(0)) << std::endl;
+ * }
+ *
+ * const auto reactor = pgfe::Reactor::make();
+ * const auto conn = pgfe::Connection::make();
+ * reactor->add(conn.get());
+ * pgfe::Async_connection<> async_conn{*reactor, conn.get()};
+ * pgfe::spawn(handle(async_conn));
+ * reactor->run();
+ * @endcode
+ *
+ * @remarks The connection must be registered by the event loop (if required
+ * by the event loop) and must not be used by the other coroutines while
+ * awaited.
+ */
+template<class EventLoop = Reactor>
+class Async_connection final {
+public:
+  /**
+   * @brief The constructor.
+   *
+   * @par Requires
+   * `(connection)`.
+   */
+  Async_connection(EventLoop& event_loop, Connection* const connection)
+    : event_loop_{&event_loop}
+    , connection_{connection}
+  {
+    DMITIGR_REQUIRE(connection_, std::invalid_argument);
+  }
+
+  /**
+   * @returns The event loop.
+   */
+  EventLoop& event_loop() const noexcept
+  {
+    return *event_loop_;
+  }
+
+  /**
+   * @returns The connection.
+   */
+  Connection* connection() const noexcept
+  {
+    return connection_;
+  }
+
+  /**
+   * @returns The awaitable which establishes the connection.
+   *
+   * @throws `std::runtime_error` upon the connection failure.
+   *
+   * @see Connection::connect().
+   */
+  auto connect() const noexcept
+  {
+    struct Awaiter final {
+      Async_connection self;
+
+      bool await_ready() const
+      {
+        return self.connection_->is_connected();
+      }
+
+      void await_suspend(const std::coroutine_handle<> handle) const
+      {
+        self.event_loop_->connect(self.connection_, [handle](Connection*) { handle.resume(); });
+      }
+
+      void await_resume() const
+      {
+        if (!self.connection_->is_connected())
+          throw std::runtime_error{"cannot connect to the server"};
+      }
+    };
+    return Awaiter{*this};
+  }
+
+  /**
+   * @returns The awaitable which awaits the response.
+   *
+   * The awaiting coroutine is resumed when either the response is available
+   * or the connection is no longer awaiting the response.
+   *
+   * @throws Server_exception if `(connection()->error() != nullptr)` after
+   * awaiting.
+   *
+   * @see Connection::wait_response_throw().
+   */
+  auto wait_response() const noexcept
+  {
+    struct Awaiter final {
+      Async_connection self;
+
+      bool await_ready() const noexcept
+      {
+        const auto* const conn = self.connection_;
+        return !conn->is_connected() || conn->is_response_available() || !conn->is_awaiting_response();
+      }
+
+      void await_suspend(const std::coroutine_handle<> handle) const
+      {
+        self.event_loop_->await_response(self.connection_, [handle](Connection*) { handle.resume(); });
+      }
+
+      void await_resume() const
+      {
+        self.connection_->throw_if_error();
+      }
+    };
+    return Awaiter{*this};
+  }
+
+  /**
+   * @brief Submits the queries and awaits the first response.
+   *
+   * @par Requires
+   * `connection()->is_ready_for_async_request()`.
+   *
+   * @see Connection::perform_async().
+   */
+  Task<> perform(const std::string queries) const
+  {
+    connection_->perform_async(queries);
+    co_await wait_response();
+  }
+
+  /**
+   * @brief Prepares the unnamed statement, executes it with the specified
+   * parameters and awaits the first response.
+   *
+   * @par Requires
+   * `connection()->is_ready_for_async_request()`.
+   *
+   * @see Connection::execute().
+   */
+  template<typename ... Types>
+  Task<> execute(const std::string statement, Types ... parameters) const
+  {
+    connection_->prepare_statement_async(statement);
+    co_await wait_response();
+    auto* const ps = connection_->prepared_statement();
+    DMITIGR_ASSERT(ps);
+    ps->set_parameters(std::move(parameters)...);
+    ps->execute_async();
+    co_await wait_response();
+  }
+
+  /**
+   * @returns The next row of the current request, or `nullptr` if there are
+   * no more rows (in which case the response which is not a row, such as the
+   * Completion, is available).
+   *
+   * @par Requires
+   * `connection()->is_connected()`.
+   */
+  Task<std::unique_ptr<Row>> next_row() const
+  {
+    if (!connection_->row() && !connection_->is_response_available())
+      co_await wait_response();
+    else
+      connection_->throw_if_error();
+
+    co_return connection_->row() ? connection_->release_row() : nullptr;
+  }
+
+private:
+  EventLoop* event_loop_{};
+  Connection* connection_{};
+};
+
+} // namespace dmitigr::pgfe
+
+#endif  // DMITIGR_PGFE_COROUTINES_HPP
@@ -0,0 +1,201 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "dmitigr/pgfe/basics.hpp"
+#include "dmitigr/pgfe/connection.hpp"
+#include "dmitigr/pgfe/cursor.hpp"
+#include "dmitigr/pgfe/row_set.hpp"
+#include "dmitigr/pgfe/implementation_header.hpp"
+
+#include <dmitigr/util/debug.hpp>
+
+#include <atomic>
+#include <optional>
+#include <string>
+
+namespace dmitigr::pgfe::detail {
+
+/**
+ * @brief The implementation of Cursor.
+ */
+class iCursor final : public Cursor {
+public:
+  /**
+   * @brief See Cursor::make().
+   */
+  iCursor(Connection* const connection, const std::string& query, const std::size_t batch_size)
+    : connection_{connection}
+    , batch_size_{batch_size}
+  {
+    DMITIGR_REQUIRE(connection_ && connection_->is_ready_for_request() &&
+      !query.empty() && batch_size_ > 0, std::invalid_argument);
+
+    static std::atomic<unsigned long long> counter;
+    name_ = "dmitigr_pgfe_cursor_" + std::to_string(++counter);
+
+    is_transaction_owner_ = !connection_->is_transaction_block_uncommitted();
+    if (is_transaction_owner_)
+      connection_->perform("BEGIN");
+
+    try {
+      connection_->perform("DECLARE " + name_ + " NO SCROLL CURSOR FOR " + query);
+      connection_->complete();
+      is_open_ = true;
+      request_batch();
+    } catch (...) {
+      is_open_ = false;
+      requested_batch_size_.reset();
+      if (is_transaction_owner_ && connection_->is_connected()) {
+        discard_responses();
+        connection_->perform("ROLLBACK");
+      }
+      throw;
+    }
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  /**
+   * @brief The destructor.
+   */
+  ~iCursor() override
+  {
+    if (is_open_) {
+      try {
+        close();
+      } catch (...) {}
+    }
+  }
+
+  /** Non copyable. */
+  iCursor(const iCursor&) = delete;
+
+  /** Non copyable. */
+  iCursor& operator=(const iCursor&) = delete;
+
+  Connection* connection() const noexcept override
+  {
+    return connection_;
+  }
+
+  const std::string& name() const noexcept override
+  {
+    return name_;
+  }
+
+  std::size_t batch_size() const noexcept override
+  {
+    return batch_size_;
+  }
+
+  void set_batch_size(const std::size_t value) override
+  {
+    DMITIGR_REQUIRE(value > 0, std::invalid_argument);
+    batch_size_ = value;
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  bool is_open() const noexcept override
+  {
+    return is_open_;
+  }
+
+  const Row_set* fetch() override
+  {
+    DMITIGR_REQUIRE(is_open(), std::logic_error);
+
+    batch_.reset();
+    if (!requested_batch_size_)
+      return nullptr;
+
+    const auto requested_batch_size = *requested_batch_size_;
+    requested_batch_size_.reset(); // no more batches upon the error
+    connection_->wait_response_throw();
+    batch_ = connection_->release_row_set();
+    connection_->complete();
+
+    // The batch which is shorter than requested is the last one.
+    if (batch_ && batch_->row_count() == requested_batch_size)
+      request_batch();
+
+    DMITIGR_ASSERT(is_invariant_ok());
+    return batch_.get();
+  }
+
+  void close() override
+  {
+    DMITIGR_REQUIRE(is_open(), std::logic_error);
+
+    is_open_ = false;
+    batch_.reset();
+    requested_batch_size_.reset();
+
+    discard_responses(); // the requested batch or the rest of the failed request
+
+    const auto status = connection_->transaction_block_status();
+    if (status == Transaction_block_status::uncommitted) {
+      connection_->perform("CLOSE " + name_);
+      if (is_transaction_owner_)
+        connection_->perform("COMMIT");
+    } else if (status == Transaction_block_status::failed && is_transaction_owner_)
+      connection_->perform("ROLLBACK");
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+private:
+  Connection* connection_{};
+  std::string name_;
+  std::size_t batch_size_{};
+  std::optional<std::size_t> requested_batch_size_;
+  std::unique_ptr<Row_set> batch_;
+  bool is_transaction_owner_{};
+  bool is_open_{};
+
+  bool is_invariant_ok() const
+  {
+    const bool connection_ok = connection_;
+    const bool batch_size_ok = batch_size_ > 0;
+    const bool open_ok = is_open_ || (!requested_batch_size_ && !batch_);
+    return connection_ok && batch_size_ok && open_ok;
+  }
+
+  // Discards the responses of the current request (if any).
+  void discard_responses()
+  {
+    if (connection_->is_awaiting_response())
+      connection_->wait_last_response();
+    connection_->dismiss_response();
+  }
+
+  // Submits the request of the next batch.
+  void request_batch()
+  {
+    DMITIGR_ASSERT(is_open_ && !requested_batch_size_);
+    const auto row_processing = connection_->row_processing();
+    connection_->set_row_processing(Row_processing::batch);
+    try {
+      connection_->perform_async("FETCH FORWARD " + std::to_string(batch_size_) + " FROM " + name_);
+    } catch (...) {
+      connection_->set_row_processing(row_processing);
+      throw;
+    }
+    connection_->set_row_processing(row_processing);
+    requested_batch_size_ = batch_size_;
+  }
+};
+
+} // namespace dmitigr::pgfe::detail
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE std::unique_ptr<Cursor>
+Cursor::make(Connection* const connection, const std::string& query, const std::size_t batch_size)
+{
+  return std::make_unique<detail::iCursor>(connection, query, batch_size);
+}
+
+} // namespace dmitigr::pgfe
+
+#include "dmitigr/pgfe/implementation_footer.hpp"
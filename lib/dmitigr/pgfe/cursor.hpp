@@ -0,0 +1,155 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_CURSOR_HPP
+#define DMITIGR_PGFE_CURSOR_HPP
+
+#include "dmitigr/pgfe/dll.hpp"
+#include "dmitigr/pgfe/types_fwd.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A server-side cursor which fetches the rows of the query by batches.
+ *
+ * The cursor is declared by `DECLARE` and the rows are retrieved by
+ * `FETCH FORWARD batch_size()`. The next batch is requested before the current
+ * one is handed to the application, so the server produces the next batch
+ * while the application consumes the current one. Thus, at most two batches
+ * are in memory at the same time regardless of the total number of rows.
+ *
+ * If the connection is not in the transaction block at the moment of creation
+ * of the cursor, then the cursor starts its own transaction block which is
+ * committed (or rolled back upon the failure) by close().
+ *
+ * @par Example
+ * @code
+ * const auto cursor = pgfe::Cursor::make(conn, "SELECT * FROM huge_table", 10000);
+ * while (const auto* const rows = cursor->fetch()) {
+ *   for (std::size_t i = 0; i < rows->row_count(); ++i)
+ *     export_row(rows, i);
+ * }
+ * cursor->close();
+ * @endcode
+ *
+ * @remarks The connection must not be used for anything else until the cursor
+ * is closed.
+ */
+class Cursor {
+public:
+  /**
+   * @brief The destructor.
+   *
+   * @remarks Calls close() and ignores the errors (if any).
+   */
+  virtual ~Cursor() = default;
+
+  /// @name Constructors
+  /// @{
+
+  /**
+   * @returns A new instance of the opened cursor.
+   *
+   * @param connection - the connection to declare the cursor on;
+   * @param query - the query which rows to fetch;
+   * @param batch_size - the number of rows to fetch at once.
+   *
+   * @par Requires
+   * `(connection && connection->is_ready_for_request() && !query.empty() && batch_size > 0)`.
+   *
+   * @par Effects
+   * `is_open()`. The first batch is requested.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  static DMITIGR_PGFE_API std::unique_ptr<Cursor> make(Connection* connection,
+    const std::string& query, std::size_t batch_size = 1000);
+
+  /// @}
+
+  /**
+   * @returns The connection of the cursor.
+   */
+  virtual Connection* connection() const noexcept = 0;
+
+  /**
+   * @returns The name of the cursor.
+   */
+  virtual const std::string& name() const noexcept = 0;
+
+  /**
+   * @returns The number of rows to fetch at once.
+   */
+  virtual std::size_t batch_size() const noexcept = 0;
+
+  /**
+   * @brief Sets the number of rows to fetch at once.
+   *
+   * @par Requires
+   * `(value > 0)`.
+   *
+   * @remarks The new value is applied starting from the batch requested by
+   * the next call of fetch(), since the next batch is already requested.
+   */
+  virtual void set_batch_size(std::size_t value) = 0;
+
+  /**
+   * @returns `true` if the cursor is open, or `false` otherwise.
+   */
+  virtual bool is_open() const noexcept = 0;
+
+  /**
+   * @returns The next batch of rows, or `nullptr` if there are no more rows.
+   * The returned batch is owned by the cursor and is valid until the next
+   * call of fetch() or close().
+   *
+   * @par Requires
+   * `is_open()`.
+   *
+   * @par Effects
+   * The batch which follows the returned one is requested (if there are
+   * possibly more rows).
+   *
+   * @par Exception safety guarantee
+   * Basic. If the error occurs then no more batches are fetched and the
+   * cursor should be closed.
+   */
+  virtual const Row_set* fetch() = 0;
+
+  /**
+   * @brief Closes the cursor.
+   *
+   * @par Requires
+   * `is_open()`.
+   *
+   * @par Effects
+   * `!is_open()`. The requested batch (if any) is discarded. The transaction
+   * block started by the cursor (if any) is committed, or rolled back if it's
+   * failed.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  virtual void close() = 0;
+
+private:
+  friend detail::iCursor;
+
+  Cursor() = default;
+};
+
+} // namespace dmitigr::pgfe
+
+#ifdef DMITIGR_PGFE_HEADER_ONLY
+#include "dmitigr/pgfe/cursor.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_CURSOR_HPP
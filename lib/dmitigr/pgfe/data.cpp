@@ -391,6 +391,81 @@ private:
   const char* bytes_{};  // No ownership
 };
 
+// =============================================================================
+
+/**
+ * @brief The implementation of Data with the inline storage of small size.
+ *
+ * @remarks Being embedded into the other object, this implementation doesn't
+ * allocate the memory dynamically at all.
+ */
+class small_Data final : public iData {
+public:
+  /**
+   * @brief The maximum size of the data.
+   */
+  static constexpr std::size_t capacity{32};
+
+  /**
+   * @brief The constructor.
+   *
+   * @par Requires
+   * `(bytes && size <= capacity)`.
+   */
+  small_Data(const char* const bytes, const std::size_t size, const Format format)
+    : format_(format)
+    , size_(size)
+  {
+    DMITIGR_ASSERT(bytes && size <= capacity);
+    std::memcpy(storage_, bytes, size);
+    storage_[size] = '\0';
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  std::unique_ptr<Data> to_data() const override
+  {
+    return Data::make(storage_, size_, format_);
+  }
+
+  Format format() const noexcept override
+  {
+    return format_;
+  }
+
+  std::size_t size() const noexcept override
+  {
+    return size_;
+  }
+
+  bool is_empty() const noexcept override
+  {
+    return (size() == 0);
+  }
+
+  const char* bytes() const noexcept override
+  {
+    return storage_;
+  }
+
+  void* memory() noexcept override
+  {
+    return storage_;
+  }
+
+protected:
+  bool is_invariant_ok() override
+  {
+    const bool size_ok = (size_ <= capacity);
+    const bool idata_ok = iData::is_invariant_ok();
+    return size_ok && idata_ok;
+  }
+
+private:
+  Format format_{Format::text};
+  std::size_t size_{};
+  char storage_[capacity + 1];
+};
+
 } // namespace dmitigr::pgfe::detail
 
 // =============================================================================
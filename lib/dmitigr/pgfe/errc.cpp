@@ -27,6 +27,8 @@ DMITIGR_PGFE_INLINE const char* to_literal(const Client_errc errc)
     return "improper_value_type_of_container";
   case Client_errc::timed_out:
     return "timed_out";
+  case Client_errc::malformed_binary_array:
+    return "malformed_binary_array";
   }
   DMITIGR_ASSERT_ALWAYS(!true);
 }
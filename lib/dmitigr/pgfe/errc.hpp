@@ -29,7 +29,10 @@ enum class Client_errc {
   improper_value_type_of_container = 400,
 
   /** Denotes a timed out operation. */
-  timed_out = 500
+  timed_out = 500,
+
+  /** Denotes a malformed array in the binary format. */
+  malformed_binary_array = 600
 };
 
 /**
@@ -12,26 +12,6 @@
 
 namespace dmitigr::pgfe::detail {
 
-/**
- * @brief The Client_exception implementation.
- */
-class iClient_exception final : public Client_exception {
-public:
-  /**
-   * @brief The constructor.
-   */
-  explicit iClient_exception(const Client_errc errc)
-    : Client_exception(errc)
-  {}
-
-  /**
-   * @overload
-   */
-  iClient_exception(const Client_errc errc, const std::string& what)
-    : Client_exception(errc, what)
-  {}
-};
-
 /**
  * @brief The Server_exception implementation.
  */
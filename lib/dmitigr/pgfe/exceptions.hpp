@@ -54,6 +54,30 @@ private:
   {}
 };
 
+namespace detail {
+
+/**
+ * @brief The Client_exception implementation.
+ */
+class iClient_exception final : public Client_exception {
+public:
+  /**
+   * @brief The constructor.
+   */
+  explicit iClient_exception(const Client_errc errc)
+    : Client_exception(errc)
+  {}
+
+  /**
+   * @overload
+   */
+  iClient_exception(const Client_errc errc, const std::string& what)
+    : Client_exception(errc, what)
+  {}
+};
+
+} // namespace detail
+
 } // namespace dmitigr::pgfe
 
 #ifdef DMITIGR_PGFE_HEADER_ONLY
@@ -0,0 +1,12 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifdef DMITIGR_PGFE_NOMINMAX
+#undef DMITIGR_PGFE_NOMINMAX
+#undef NOMINMAX
+#endif
+
+#ifdef DMITIGR_PGFE_INLINE
+#undef DMITIGR_PGFE_INLINE
+#endif
@@ -0,0 +1,122 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_INSTRUMENTATION_HPP
+#define DMITIGR_PGFE_INSTRUMENTATION_HPP
+
+#include "dmitigr/pgfe/types_fwd.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief The information about the request which is passed to the request
+ * handlers of the connection.
+ *
+ * @see Connection::set_request_start_handler(), Connection::set_request_finish_handler().
+ */
+struct Request_info final {
+  /**
+   * @brief The name of the prepared statement which is prepared, described
+   * or executed by the request, or empty string otherwise.
+   */
+  std::string name;
+
+  /**
+   * @brief The query (or queries) which is performed or prepared by the
+   * request, or empty string otherwise.
+   */
+  std::string query;
+
+  /**
+   * @brief The number of the parameters of the execution of the prepared statement.
+   */
+  std::size_t parameter_count{};
+
+  /**
+   * @brief The time elapsed from the submission of the request until its
+   * last response is collected. (Known when the request is finished.)
+   */
+  std::chrono::nanoseconds elapsed{};
+
+  /**
+   * @brief The number of rows received. (Known when the request is finished.)
+   */
+  std::size_t row_count{};
+
+  /**
+   * @brief The total size of the data of the rows received in bytes. (Known
+   * when the request is finished.)
+   */
+  std::size_t byte_count{};
+
+  /**
+   * @brief `true` if the request provoked the Error. (Known when the
+   * request is finished.)
+   */
+  bool is_failed{};
+};
+
+/**
+ * @ingroup main
+ *
+ * @brief The cumulative statistics of the requests of the connection.
+ *
+ * @see Connection::statistics().
+ */
+struct Connection_statistics final {
+  /**
+   * @brief The upper bounds of the buckets of `duration_histogram` (except
+   * the last bucket which is unbounded).
+   */
+  static constexpr std::array<std::chrono::microseconds, 5> duration_bucket_bounds{
+    std::chrono::microseconds{100},
+    std::chrono::microseconds{1000},
+    std::chrono::microseconds{10000},
+    std::chrono::microseconds{100000},
+    std::chrono::microseconds{1000000}};
+
+  /**
+   * @brief The number of the finished requests.
+   */
+  std::uint_fast64_t request_count{};
+
+  /**
+   * @brief The number of the finished requests which provoked the Error.
+   */
+  std::uint_fast64_t error_count{};
+
+  /**
+   * @brief The number of rows received.
+   */
+  std::uint_fast64_t row_count{};
+
+  /**
+   * @brief The total size of the data of the rows received in bytes.
+   */
+  std::uint_fast64_t byte_count{};
+
+  /**
+   * @brief The cumulative time spent in waiting for responses.
+   */
+  std::chrono::nanoseconds wait_time{};
+
+  /**
+   * @brief The numbers of the finished requests by their elapsed time. The
+   * request with the elapsed time `t` is counted in the first bucket `i` for
+   * which `(t < duration_bucket_bounds[i])`, or in the last bucket.
+   */
+  std::array<std::uint_fast64_t, duration_bucket_bounds.size() + 1> duration_histogram{};
+};
+
+} // namespace dmitigr::pgfe
+
+#endif  // DMITIGR_PGFE_INSTRUMENTATION_HPP
@@ -0,0 +1,193 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "dmitigr/pgfe/basics.hpp"
+#include "dmitigr/pgfe/connection.hpp"
+#include "dmitigr/pgfe/notification.hpp"
+#include "dmitigr/pgfe/notification_dispatcher.hpp"
+#include "dmitigr/pgfe/implementation_header.hpp"
+
+#include <dmitigr/util/debug.hpp>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace dmitigr::pgfe::detail {
+
+/**
+ * @brief The implementation of Notification_dispatcher.
+ */
+class iNotification_dispatcher final : public Notification_dispatcher {
+public:
+  /**
+   * @brief See Notification_dispatcher::make().
+   */
+  explicit iNotification_dispatcher(std::unique_ptr<Connection> connection)
+    : connection_{std::move(connection)}
+  {
+    DMITIGR_REQUIRE(connection_ && !connection_->is_awaiting_response(), std::invalid_argument);
+    connection_->set_notification_handler({});
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  /** Non copyable. */
+  iNotification_dispatcher(const iNotification_dispatcher&) = delete;
+
+  /** Non copyable. */
+  iNotification_dispatcher& operator=(const iNotification_dispatcher&) = delete;
+
+  Connection* connection() const noexcept override
+  {
+    return connection_.get();
+  }
+
+  void subscribe(const std::string& channel, Handler handler) override
+  {
+    DMITIGR_REQUIRE(!channel.empty() && handler, std::invalid_argument);
+
+    if (const auto i = subscriptions_.find(channel); i != cend(subscriptions_)) {
+      i->second = std::move(handler);
+      return;
+    }
+
+    const auto i = subscriptions_.emplace(channel, std::move(handler)).first; // can throw
+    try {
+      if (connection_->is_connected())
+        listen(channel);
+    } catch (...) {
+      subscriptions_.erase(i); // rollback
+      throw;
+    }
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  void unsubscribe(const std::string& channel) override
+  {
+    const auto i = subscriptions_.find(channel);
+    if (i == cend(subscriptions_))
+      return;
+
+    if (connection_->is_connected())
+      unlisten(channel); // can throw
+    subscriptions_.erase(i);
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  bool has_subscription(const std::string& channel) const override
+  {
+    return subscriptions_.find(channel) != cend(subscriptions_);
+  }
+
+  std::size_t subscription_count() const noexcept override
+  {
+    return subscriptions_.size();
+  }
+
+  std::size_t dispatch(const std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) override
+  {
+    DMITIGR_REQUIRE(timeout >= std::chrono::milliseconds{-1}, std::invalid_argument);
+
+    if (!connection_->is_connected())
+      reconnect();
+
+    // Collect the notifications which are already received first.
+    collect();
+    if (!connection_->notification()) {
+      if (connection_->wait_socket_readiness(Socket_readiness::read_ready, timeout) == Socket_readiness::read_ready)
+        collect();
+    }
+
+    /*
+     * Group the notifications by channels (in the order of the first arrival)
+     * to deliver them to each subscriber at once.
+     */
+    std::vector<std::pair<std::string, std::vector<std::unique_ptr<Notification>>>> batches;
+    while (auto n = connection_->pop_notification()) {
+      const auto& channel = n->channel_name();
+      const auto b = std::find_if(begin(batches), end(batches),
+        [&channel](const auto& batch) { return batch.first == channel; });
+      if (b != end(batches))
+        b->second.push_back(std::move(n));
+      else
+        batches.emplace_back(channel, std::vector<std::unique_ptr<Notification>>{}).second.push_back(std::move(n));
+    }
+
+    std::size_t result{};
+    for (const auto& batch : batches) {
+      // Note: the subscriptions can be changed by the subscribers.
+      if (const auto s = subscriptions_.find(batch.first); s != cend(subscriptions_)) {
+        const auto handler = s->second;
+        handler(batch.second);
+        result += batch.second.size();
+      }
+    }
+
+    DMITIGR_ASSERT(is_invariant_ok());
+    return result;
+  }
+
+private:
+  std::unique_ptr<Connection> connection_;
+  std::map<std::string, Handler> subscriptions_;
+
+  bool is_invariant_ok() const
+  {
+    return bool(connection_);
+  }
+
+  // Collects the server messages and handles the notices.
+  void collect()
+  {
+    connection_->collect_server_messages();
+    connection_->handle_signals();
+  }
+
+  // Listens the channel.
+  void listen(const std::string& channel)
+  {
+    connection_->perform("LISTEN " + connection_->to_quoted_identifier(channel));
+    connection_->complete();
+  }
+
+  // Unlistens the channel.
+  void unlisten(const std::string& channel)
+  {
+    connection_->perform("UNLISTEN " + connection_->to_quoted_identifier(channel));
+    connection_->complete();
+  }
+
+  // Connects and listens all the subscribed channels.
+  void reconnect()
+  {
+    connection_->connect();
+    if (!connection_->is_connected())
+      throw std::runtime_error{"cannot connect to the server to listen the notifications"};
+
+    try {
+      for (const auto& [channel, handler] : subscriptions_)
+        listen(channel);
+    } catch (...) {
+      connection_->disconnect(); // to listen all the channels upon the next attempt
+      throw;
+    }
+  }
+};
+
+} // namespace dmitigr::pgfe::detail
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE std::unique_ptr<Notification_dispatcher>
+Notification_dispatcher::make(std::unique_ptr<Connection> connection)
+{
+  return std::make_unique<detail::iNotification_dispatcher>(std::move(connection));
+}
+
+} // namespace dmitigr::pgfe
+
+#include "dmitigr/pgfe/implementation_footer.hpp"
@@ -0,0 +1,168 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_NOTIFICATION_DISPATCHER_HPP
+#define DMITIGR_PGFE_NOTIFICATION_DISPATCHER_HPP
+
+#include "dmitigr/pgfe/dll.hpp"
+#include "dmitigr/pgfe/types_fwd.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A dispatcher of the notifications (see `LISTEN` and `NOTIFY`) to the
+ * subscribers of the channels.
+ *
+ * The dispatcher owns the connection which is used exclusively for listening.
+ * Each call of dispatch() waits on the socket of the connection and delivers
+ * the notifications collected by the time of the wake up. Thus, under the
+ * burst of notifications the subscriber is called once with all the
+ * notifications of its channel collected at once (in the order of arrival).
+ *
+ * If the connection is lost, dispatch() reconnects and `LISTEN`s all the
+ * subscribed channels again. (The notifications sent in the meantime are lost,
+ * so the subscriber might want to treat the reconnection as the notification
+ * of everything.)
+ *
+ * @par Example
+ * @code
+ * const auto dispatcher = pgfe::Notification_dispatcher::make(pgfe::Connection::make());
+ * dispatcher->subscribe("cache_invalidation", [&cache](const auto& notifications)
+ * {
+ *   for (const auto& n : notifications)
+ *     cache.invalidate(pgfe::to<std::string>(n->payload()));
+ * });
+ * while (is_running)
+ *   dispatcher->dispatch(std::chrono::seconds{1});
+ * @endcode
+ *
+ * @remarks The instance of this class is not thread-safe.
+ */
+class Notification_dispatcher {
+public:
+  /**
+   * @brief The alias of the subscriber of the channel.
+   *
+   * The subscriber is called with the non-empty batch of the notifications
+   * of the channel.
+   */
+  using Handler = std::function<void(const std::vector<std::unique_ptr<Notification>>&)>;
+
+  /**
+   * @brief The destructor.
+   */
+  virtual ~Notification_dispatcher() = default;
+
+  /// @name Constructors
+  /// @{
+
+  /**
+   * @returns A new instance of the dispatcher.
+   *
+   * @param connection - the connection to listen on. (The connection may be
+   * connected or not.)
+   *
+   * @par Requires
+   * `(connection && !connection->is_awaiting_response())`.
+   *
+   * @par Effects
+   * The notification handler of the `connection` is reset.
+   */
+  static DMITIGR_PGFE_API std::unique_ptr<Notification_dispatcher> make(std::unique_ptr<Connection> connection);
+
+  /// @}
+
+  /**
+   * @returns The connection of the dispatcher.
+   *
+   * @remarks The connection must not be used to perform the requests while
+   * the dispatcher is used.
+   */
+  virtual Connection* connection() const noexcept = 0;
+
+  /**
+   * @brief Subscribes the `handler` to the notifications of the `channel`.
+   *
+   * If the `channel` is already subscribed, then its subscriber is replaced.
+   *
+   * @par Requires
+   * `(!channel.empty() && handler)`.
+   *
+   * @par Effects
+   * `has_subscription(channel)`. The `LISTEN` command is performed if the
+   * connection is connected.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  virtual void subscribe(const std::string& channel, Handler handler) = 0;
+
+  /**
+   * @brief Unsubscribes from the notifications of the `channel`.
+   *
+   * @par Effects
+   * `!has_subscription(channel)`. The `UNLISTEN` command is performed if the
+   * `channel` was subscribed and the connection is connected.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  virtual void unsubscribe(const std::string& channel) = 0;
+
+  /**
+   * @returns `true` if the `channel` is subscribed, or `false` otherwise.
+   */
+  virtual bool has_subscription(const std::string& channel) const = 0;
+
+  /**
+   * @returns The number of the subscribed channels.
+   */
+  virtual std::size_t subscription_count() const noexcept = 0;
+
+  /**
+   * @brief Waits for the notifications and delivers them to the subscribers.
+   *
+   * If the connection is not connected, it's connected and all the subscribed
+   * channels are listened before waiting.
+   *
+   * @returns The number of the delivered notifications.
+   *
+   * @param timeout - the maximum amount of time to wait for the notifications.
+   * The special value of `-1` denotes *eternity*.
+   *
+   * @par Requires
+   * `(timeout >= -1)`.
+   *
+   * @par Exception safety guarantee
+   * Basic. If the connection is lost, then the exception is propagated and the
+   * reconnection is performed by the next call. If the subscriber throws, then
+   * the notifications which are not delivered yet are lost.
+   *
+   * @remarks The notifications of the channels without subscribers (possible
+   * while unsubscribing) are ignored.
+   */
+  virtual std::size_t dispatch(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) = 0;
+
+private:
+  friend detail::iNotification_dispatcher;
+
+  Notification_dispatcher() = default;
+};
+
+} // namespace dmitigr::pgfe
+
+#ifdef DMITIGR_PGFE_HEADER_ONLY
+#include "dmitigr/pgfe/notification_dispatcher.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_NOTIFICATION_DISPATCHER_HPP
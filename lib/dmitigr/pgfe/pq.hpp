@@ -12,6 +12,10 @@
 
 #include <libpq-fe.h>
 
+#ifndef LIBPQ_HAS_PIPELINING
+#error libpq 14 or newer is required
+#endif
+
 #include <memory>
 
 namespace std {
@@ -334,6 +338,14 @@ public:
     return ::PQnfields(pg_result());
   }
 
+  /**
+   * @returns The number of bytes allocated for the result.
+   */
+  std::size_t memory_size() const noexcept
+  {
+    return ::PQresultMemorySize(pg_result());
+  }
+
   /**
    * @returns `nullptr` if the `position` is out of range.
    */
@@ -10,10 +10,15 @@
 #include "dmitigr/pgfe/parameterizable.hpp"
 #include "dmitigr/pgfe/response.hpp"
 
+#include <charconv>
 #include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -97,6 +102,9 @@ public:
    *
    * @par Requires
    * `(index < parameter_count())`.
+   *
+   * @remarks The returned value is valid until the parameter is bound again.
+   * (The binding of the other parameters doesn't affect it.)
    */
   virtual const Data* parameter(std::size_t index) const = 0;
 
@@ -158,14 +166,41 @@ public:
    *
    * Similar to set_parameter(std::size_t, std::unique_ptr<Data>&&) but binds
    * the parameter of the specified index with the value of type `T`, implicitly
-   * converted to the Data by using to_data().
+   * converted to the Data by using to_data(). If `Is_binary_data_convertible_v<T>`
+   * and `(parameter_format() == Data_format::binary)` then the value is converted
+   * to the Data in the Data_format::binary format.
    *
    * @par Requires
    * The value must be convertible to the Data.
+   *
+   * @remarks The values of the signed integer types and the strings of size up
+   * to `inline_parameter_size` are bound by using set_parameter_copy() without
+   * dynamic memory allocations (except the first such a binding of the parameter).
+   *
+   * @see set_parameter_format().
    */
   template<typename T>
   std::enable_if_t<!std::is_same_v<Data*, T>> set_parameter(std::size_t index, T&& value)
   {
+    using U = std::decay_t<T>;
+    if constexpr (Is_inline_integral__<U>) {
+      char buffer[inline_parameter_size];
+      const auto format = parameter_format();
+      set_parameter_copy(index, to_chars__(buffer, value, format), format);
+      return;
+    } else if constexpr (std::is_same_v<U, std::string>) {
+      if (value.size() <= inline_parameter_size) {
+        set_parameter_copy(index, value);
+        return;
+      }
+    }
+
+    if constexpr (Is_binary_data_convertible_v<U>) {
+      if (parameter_format() == Data_format::binary) {
+        set_parameter(index, to_data(std::forward<T>(value), Data_format::binary));
+        return;
+      }
+    }
     set_parameter(index, to_data(std::forward<T>(value)));
   }
 
@@ -206,6 +241,40 @@ public:
    */
   virtual void set_parameter_no_copy(const std::string& name, const Data* data) = 0;
 
+  /**
+   * @brief The maximum size of the parameter data which is stored in the
+   * storage of the parameter itself.
+   */
+  static constexpr std::size_t inline_parameter_size{32};
+
+  /**
+   * @brief Similar to set_parameter(std::size_t, std::unique_ptr<Data>&&) but
+   * binds the parameter of the specified index with a copy of the `bytes`.
+   *
+   * The copy of size up to `inline_parameter_size` is placed into the storage
+   * of the parameter which is allocated once and reused by the subsequent
+   * bindings, so the binding of such a data doesn't allocate the memory
+   * dynamically (except the first one).
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see parameter().
+   */
+  virtual void set_parameter_copy(std::size_t index, std::string_view bytes,
+    Data_format format = Data_format::text) = 0;
+
+  /**
+   * @overload
+   *
+   * @par Requries
+   * `(has_parameter(name))`
+   *
+   * @see parameter(), has_parameter().
+   */
+  virtual void set_parameter_copy(const std::string& name, std::string_view bytes,
+    Data_format format = Data_format::text) = 0;
+
   /**
    * @brief Binds parameters by indexes in range [0, sizeof ... (values)).
    *
@@ -231,6 +300,37 @@ public:
     set_parameters__(std::make_index_sequence<sizeof ... (Types)>{}, std::forward<Types>(values)...);
   }
 
+  /**
+   * @brief Sets the preferred data format of the parameters which are bound
+   * by using set_parameter() with the values of native types.
+   *
+   * @par Effects
+   * The values of the types for which `Is_binary_data_convertible_v` is `true`
+   * are converted to the Data in the specified format on subsequent calls of
+   * set_parameter() (the values of the other types are always converted to the
+   * Data in the Data_format::text format). Binding the binary parameters saves
+   * both the formatting of the values on the client side and parsing of them
+   * on the server side.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The parameters which are already bound are not affected.
+   * @remarks The data in the Data_format::binary format must exactly match the
+   * type of the parameter on the server side (for example, `int` must be bound
+   * only to the parameter of the `integer` type).
+   *
+   * @see Connection::set_parameter_format().
+   */
+  virtual void set_parameter_format(Data_format format) = 0;
+
+  /**
+   * @returns The preferred data format of the parameters.
+   *
+   * @see Connection::parameter_format().
+   */
+  virtual Data_format parameter_format() const noexcept = 0;
+
   /**
    * @brief Sets the data format for all fields of rows that will be produced
    * during the execution of a SQL command.
@@ -287,6 +387,86 @@ public:
    */
   virtual void execute() = 0;
 
+  /**
+   * @brief The alias of the handler of the Error provoked by one of the
+   * executions of execute_batch().
+   *
+   * The handler is called with the index of the set of parameters of the
+   * failed execution.
+   */
+  using Batch_error_handler = std::function<void(std::size_t, std::unique_ptr<Error>&&)>;
+
+  /**
+   * @brief Executes this prepared statement with each set of parameters bound
+   * by `bind_next` in the pipeline with the single synchronization point.
+   *
+   * The executions are submitted without waiting for their responses, so the
+   * whole batch costs just about one round trip. (The responses are collected
+   * while submitting to limit the number of executions in flight.)
+   *
+   * @param bind_next - the function which either binds the next set of
+   * parameters and returns `true`, or returns `false` if there are no more sets;
+   * @param error_handler - the handler of the Error. If not set then the
+   * Server_exception is thrown upon the Error after all of the responses are
+   * collected.
+   *
+   * @returns The Completion which aggregates the Completions of all of the
+   * executions (the affected row counts are summed), or `nullptr` if there
+   * were no executions or one of them is failed.
+   *
+   * @par Requires
+   * `connection()->is_ready_for_request()`.
+   *
+   * @par Effects
+   * The parameters are bound as by the last call of `bind_next`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @remarks The executions share the same (implicit, unless the explicit
+   * transaction block is started) transaction. Thus, upon the Error all of the
+   * executions are rolled back, and the executions following the failed one
+   * are rejected by the server. If `bind_next` or the submission throws, the
+   * transaction is forced to abort (by the failing `DO` statement) before the
+   * synchronization point, so none of the executions are committed either.
+   * If the responses cannot be collected upon an exception (for example, if
+   * the connection is broken), then the connection is closed (and thus this
+   * instance is destroyed) and the original exception is rethrown.
+   * @remarks The rows produced by the executions (if any) are dismissed.
+   * @remarks The pipeline mode is enabled for the batch if it's disabled.
+   *
+   * @see Connection::set_pipeline_enabled().
+   */
+  virtual std::unique_ptr<Completion> execute_batch(const std::function<bool()>& bind_next,
+    const Batch_error_handler& error_handler = {}) = 0;
+
+  /**
+   * @overload
+   *
+   * @param parameter_sets - the range of the sets of parameters. Each element
+   * of the range is either a tuple-like object (such as `std::tuple`) of the
+   * values of the parameters, or the value of the sole parameter.
+   *
+   * @par Requires
+   * Each value must be Data-convertible.
+   */
+  template<class Range>
+  std::enable_if_t<!std::is_invocable_v<const Range&>, std::unique_ptr<Completion>>
+  execute_batch(const Range& parameter_sets, const Batch_error_handler& error_handler = {})
+  {
+    auto i = std::cbegin(parameter_sets);
+    const auto e = std::cend(parameter_sets);
+    return execute_batch([this, &i, &e]
+    {
+      if (i == e)
+        return false;
+
+      set_parameter_set__(*i);
+      ++i;
+      return true;
+    }, error_handler);
+  }
+
   /**
    * @returns The pointer to the instance of type Connection on which this
    * statement is prepared.
@@ -355,6 +535,42 @@ private:
   {
     (set_parameter(I, std::forward<Types>(args)), ...);
   }
+
+  template<typename T>
+  static constexpr bool Is_inline_integral__ = std::is_same_v<T, short int> || std::is_same_v<T, int> ||
+    std::is_same_v<T, long int> || std::is_same_v<T, long long int>;
+
+  // Writes the value to the buffer just like Conversions<T>::to_data() does.
+  template<typename T>
+  static std::string_view to_chars__(char (&buffer)[inline_parameter_size], const T value, const Data_format format)
+  {
+    if (format == Data_format::binary) {
+      // In the network byte order.
+      const auto uvalue = static_cast<std::make_unsigned_t<T>>(value);
+      for (std::size_t i = 0; i < sizeof(T); ++i)
+        buffer[i] = static_cast<char>((uvalue >> ((sizeof(T) - 1 - i) * 8)) & 0xff);
+      return {buffer, sizeof(T)};
+    } else {
+      const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+      DMITIGR_ASSERT(ec == std::errc{});
+      return {buffer, static_cast<std::size_t>(ptr - buffer)};
+    }
+  }
+
+  template<typename T, typename = void>
+  struct Is_tuple_like final : std::false_type {};
+
+  template<typename T>
+  struct Is_tuple_like<T, std::void_t<decltype (std::tuple_size<T>::value)>> final : std::true_type {};
+
+  template<typename T>
+  void set_parameter_set__(const T& values)
+  {
+    if constexpr (Is_tuple_like<T>::value)
+      std::apply([this](const auto& ... vs) { set_parameters(vs...); }, values);
+    else
+      set_parameter(0, values);
+  }
 };
 
 } // namespace dmitigr::pgfe
@@ -2,7 +2,10 @@
 // Copyright (C) Dmitry Igrishin
 // For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
 
+#include "dmitigr/pgfe/completion.hpp"
 #include "dmitigr/pgfe/connection.hpp"
+#include "dmitigr/pgfe/error.hpp"
+#include "dmitigr/pgfe/exceptions.hpp"
 #include "dmitigr/pgfe/prepared_statement_impl.hpp"
 #include "dmitigr/pgfe/implementation_header.hpp"
 
@@ -46,6 +49,7 @@ inline void pq_Prepared_statement::init_connection__(pq_Connection* const connec
   DMITIGR_ASSERT(connection && connection->session_start_time());
   connection_ = connection;
   session_start_time_ = *connection_->session_start_time();
+  parameter_format_ = connection_->parameter_format();
   result_format_ = connection_->result_format();
 }
 
@@ -55,11 +59,16 @@ inline void pq_Prepared_statement::execute_async()
 
   // All values are NULLs. (Can throw.)
   const int param_count = int(parameter_count());
-  std::vector<const char*> values(param_count, nullptr);
-  std::vector<int> lengths(param_count, 0);
-  std::vector<int> formats(param_count, 0);
-
-  connection_->requests_.push(pq_Connection::Request_id::execute); // can throw
+  auto& values = parameter_values_;
+  auto& lengths = parameter_lengths_;
+  auto& formats = parameter_formats_;
+  values.assign(param_count, nullptr);
+  lengths.assign(param_count, 0);
+  formats.assign(param_count, 0);
+
+  pq_Connection::Request request{pq_Connection::Request_id::execute};
+  request.prepared_statement_name = name_; // can throw
+  connection_->push_request(std::move(request), name_, {}, std::size_t(param_count)); // can throw
   try {
     // Prepare the input for libpq.
     for (int i = 0; i < param_count; ++i) {
@@ -76,11 +85,9 @@ inline void pq_Prepared_statement::execute_async()
     if (!send_ok)
       throw std::runtime_error(connection_->error_message());
 
-    const auto set_ok = ::PQsetSingleRowMode(connection_->conn_);
-    DMITIGR_ASSERT_ALWAYS(set_ok);
-    connection_->dismiss_response(); // cannot throw
+    connection_->request_sent(); // cannot throw
   } catch (...) {
-    connection_->requests_.pop(); // rollback
+    connection_->cancel_request(); // rollback
     throw;
   }
 
@@ -95,6 +102,120 @@ inline void pq_Prepared_statement::execute()
   DMITIGR_ASSERT(is_invariant_ok());
 }
 
+inline std::unique_ptr<Completion> pq_Prepared_statement::execute_batch(const std::function<bool()>& bind_next,
+  const Batch_error_handler& error_handler)
+{
+  DMITIGR_REQUIRE(connection()->is_ready_for_request() && bind_next, std::logic_error);
+
+  const bool is_pipeline_enabled = connection_->is_pipeline_enabled();
+  if (!is_pipeline_enabled)
+    connection_->set_pipeline_enabled(true);
+
+  // Collects the responses to the submitted requests and restores the pipeline mode.
+  const auto finish = [this, is_pipeline_enabled]
+  {
+    if (connection_->is_awaiting_response())
+      connection_->wait_last_response();
+    connection_->dismiss_response();
+    if (!is_pipeline_enabled)
+      connection_->set_pipeline_enabled(false);
+  };
+
+  bool is_failed{};
+  std::shared_ptr<Error> error;
+  std::string operation_name;
+  std::optional<unsigned long long> affected_row_count;
+
+  // Collects the response to the execution with the specified index.
+  const auto collect = [&](const std::size_t index)
+  {
+    connection_->wait_response();
+    while (connection_->row() || connection_->row_set()) {
+      connection_->dismiss_response();
+      connection_->wait_response();
+    }
+
+    if (auto e = connection_->release_error()) {
+      is_failed = true;
+      if (error_handler)
+        error_handler(index, std::move(e));
+      else if (!error)
+        error = std::move(e);
+    } else if (const auto* const c = connection_->completion()) {
+      if (c->operation_name() == "pipeline_aborted")
+        is_failed = true;
+      else {
+        if (operation_name.empty())
+          operation_name = c->operation_name();
+        if (const auto& count = c->affected_row_count())
+          affected_row_count = affected_row_count.value_or(0) + std::stoull(*count);
+      }
+      connection_->dismiss_response();
+    }
+  };
+
+  std::size_t execution_count{};
+  std::size_t collected_count{};
+  try {
+    while (bind_next()) {
+      execute_async();
+      ++execution_count;
+
+      /*
+       * The responses are collected while submitting to bound the amount of
+       * the output of the server which is not yet read. (Otherwise, both the
+       * client and the server could block on writing to the full socket.)
+       */
+      if (execution_count - collected_count > batch_window_size)
+        collect(collected_count++);
+    }
+  } catch (...) {
+    /*
+     * The synchronization point commits the implicit transaction of the
+     * executions which are already submitted, so the transaction is forced
+     * to abort before in order to not to break the atomicity of the batch.
+     * If this fails too (for example, if the connection is broken) then the
+     * connection is closed, so the transaction cannot be committed anyway.
+     * Either way the original exception is rethrown.
+     */
+    auto* const connection = connection_;
+    try {
+      connection->dismiss_response();
+      if (execution_count)
+        connection->perform_async("DO $$BEGIN RAISE EXCEPTION 'batch is aborted by the client'; END$$");
+      connection->synchronize_pipeline_async();
+      finish();
+    } catch (...) {
+      connection->disconnect(); // destroys this instance
+    }
+    throw;
+  }
+  connection_->synchronize_pipeline_async();
+
+  try {
+    while (collected_count < execution_count)
+      collect(collected_count++);
+    finish(); // the Completion of the synchronization point
+  } catch (...) {
+    auto* const connection = connection_;
+    try {
+      finish();
+    } catch (...) {
+      connection->disconnect(); // destroys this instance
+    }
+    throw;
+  }
+
+  if (error)
+    throw iServer_exception(std::move(error));
+  else if (is_failed || !execution_count)
+    return nullptr;
+  else if (affected_row_count)
+    return std::make_unique<simple_Completion>(operation_name + " " + std::to_string(*affected_row_count));
+  else
+    return std::make_unique<simple_Completion>(operation_name);
+}
+
 inline Connection* pq_Prepared_statement::connection()
 {
   return connection_;
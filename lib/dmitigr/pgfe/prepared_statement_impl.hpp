@@ -5,6 +5,7 @@
 #ifndef DMITIGR_PGFE_PREPARED_STATEMENT_IMPL_HPP
 #define DMITIGR_PGFE_PREPARED_STATEMENT_IMPL_HPP
 
+#include "dmitigr/pgfe/data.hpp"
 #include "dmitigr/pgfe/exceptions.hpp"
 #include "dmitigr/pgfe/parameterizable.hpp"
 #include "dmitigr/pgfe/pq.hpp"
@@ -16,7 +17,9 @@
 #include <algorithm>
 #include <chrono>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
@@ -164,7 +167,7 @@ public:
     DMITIGR_REQUIRE(index < parameter_count(), std::out_of_range,
       "invalid parameter index (" + std::to_string(index) + ")"
       " of the dmitigr::pgfe::Prepared_statement instance");
-    return parameters_[index].data.get();
+    return parameters_[index].get();
   }
 
   const Data* parameter(const std::string& name) const override
@@ -206,6 +209,41 @@ public:
     set_parameter(parameter_index_throw(name), std::move(d));
   }
 
+  void set_parameter_copy(const std::size_t index, const std::string_view bytes,
+    const Data_format format = Data_format::text) override
+  {
+    if (bytes.size() <= small_Data::capacity) {
+      DMITIGR_REQUIRE(is_parameter_index_ok(index), std::out_of_range);
+      prepare_parameter(index);
+      auto& p = parameters_[index];
+      if (p.small_data)
+        *p.small_data = small_Data{bytes.data(), bytes.size(), format};
+      else
+        p.small_data = std::make_unique<small_Data>(bytes.data(), bytes.size(), format); // can throw
+      p.data.reset();
+      p.is_small_data_bound = true;
+      DMITIGR_ASSERT(is_invariant_ok());
+    } else
+      set_parameter(index, Data::make(std::string{bytes}, format));
+  }
+
+  void set_parameter_copy(const std::string& name, const std::string_view bytes,
+    const Data_format format = Data_format::text) override
+  {
+    set_parameter_copy(parameter_index_throw(name), bytes, format);
+  }
+
+  void set_parameter_format(const Data_format format) override
+  {
+    parameter_format_ = format;
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  Data_format parameter_format() const noexcept override
+  {
+    return parameter_format_;
+  }
+
   void set_result_format(const Data_format format) override
   {
     result_format_ = format;
@@ -221,6 +259,9 @@ public:
 
   void execute() override;
 
+  std::unique_ptr<Completion> execute_batch(const std::function<bool()>& bind_next,
+    const Batch_error_handler& error_handler) override;
+
   Connection* connection() override;
 
   const Connection* connection() const override;
@@ -278,23 +319,55 @@ private:
   using Data_deletion_required = memory::Conditional_delete<const Data>;
   using Data_ptr = std::unique_ptr<const Data, Data_deletion_required>;
 
+  static_assert(small_Data::capacity == inline_parameter_size);
+
+  /*
+   * The maximum number of executions of execute_batch() which responses are
+   * not yet collected.
+   */
+  static constexpr std::size_t batch_window_size{256};
+
   struct Parameter final {
     Data_ptr data;
+    /*
+     * The storage for the small data which is reused by the subsequent bindings.
+     * It's allocated separately, so the pointers returned by parameter() are
+     * not invalidated when the vector of the parameters grows.
+     */
+    std::unique_ptr<small_Data> small_data;
+    bool is_small_data_bound{};
     std::string name;
+
+    const Data* get() const noexcept
+    {
+      return is_small_data_bound ? small_data.get() : data.get();
+    }
   };
 
   bool is_invariant_ok() override;
 
+  bool is_parameter_index_ok(const std::size_t index) const noexcept
+  {
+    return (!is_preparsed() && !is_described()) ?
+      index < maximum_parameter_count() : index < parameter_count();
+  }
+
+  // Makes the parameter of the specified index available.
+  void prepare_parameter(const std::size_t index)
+  {
+    DMITIGR_ASSERT(is_parameter_index_ok(index));
+    if (index >= parameters_.size())
+      parameters_.resize(index + 1);
+  }
+
   void set_parameter(const std::size_t index, Data_ptr&& data)
   {
     DMITIGR_REQUIRE(!data || data->size() <= maximum_data_size(), std::invalid_argument);
-    if (!is_preparsed() && !is_described()) {
-      DMITIGR_REQUIRE(index < maximum_parameter_count(), std::out_of_range);
-      if (index >= parameters_.size())
-        parameters_.resize(index + 1);
-    } else
-      DMITIGR_REQUIRE(index < parameter_count(), std::out_of_range);
-    parameters_[index].data = std::move(data);
+    DMITIGR_REQUIRE(is_parameter_index_ok(index), std::out_of_range);
+    prepare_parameter(index);
+    auto& p = parameters_[index];
+    p.data = std::move(data);
+    p.is_small_data_bound = false; // the storage is retained
     DMITIGR_ASSERT(is_invariant_ok());
   }
 
@@ -303,9 +376,10 @@ private:
     if (!preparsed_)
       parameters_.resize(std::size_t(r.ps_param_count()));
 
-    if (r.field_count() > 0)
+    if (r.field_count() > 0) {
       description_ = pq_Row_info(std::move(r));
-    else
+      shared_field_names_ = std::get<pq_Row_info>(*description_).shared_field_names_;
+    } else
       description_ = std::move(r);
 
     DMITIGR_ASSERT(is_invariant_ok());
@@ -321,15 +395,44 @@ private:
     return i - b;
   }
 
+  // Returns the approximate number of bytes allocated for this instance.
+  std::size_t memory_size() const noexcept
+  {
+    std::size_t result = sizeof(*this) + name_.capacity() + parameters_.capacity() * sizeof(Parameter);
+    for (const auto& p : parameters_) {
+      result += p.name.capacity();
+      if (p.small_data)
+        result += sizeof(small_Data);
+      if (p.data && p.data.get_deleter().condition())
+        result += p.data->size(); // owned data only
+    }
+    if (description_) {
+      result += std::visit([](const auto& d) -> std::size_t
+      {
+        using T = std::decay_t<decltype (d)>;
+        if constexpr (std::is_same_v<T, pq::Result>)
+          return d.memory_size();
+        else
+          return d.pq_result_.memory_size();
+      }, *description_);
+    }
+    return result;
+  }
+
   constexpr static std::size_t maximum_parameter_count_{65536 - 1};
   constexpr static std::size_t maximum_data_size_{std::size_t(std::numeric_limits<int>::max())};
+  Data_format parameter_format_{Data_format::text};
   Data_format result_format_{Data_format::text};
   std::string name_;
   bool preparsed_{};
   pq_Connection* connection_{};
   std::chrono::system_clock::time_point session_start_time_;
   std::vector<Parameter> parameters_;
+  std::vector<const char*> parameter_values_; // cache
+  std::vector<int> parameter_lengths_; // cache
+  std::vector<int> parameter_formats_; // cache
   std::optional<std::variant<pq::Result, pq_Row_info>> description_;
+  std::shared_ptr<const Field_names> shared_field_names_; // cache
 };
 
 } // namespace dmitigr::pgfe::detail
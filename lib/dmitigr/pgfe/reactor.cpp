@@ -0,0 +1,422 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "dmitigr/pgfe/basics.hpp"
+#include "dmitigr/pgfe/connection.hpp"
+#include "dmitigr/pgfe/reactor.hpp"
+#include "dmitigr/pgfe/implementation_header.hpp"
+
+#include <dmitigr/util/debug.hpp>
+#include <dmitigr/util/exceptions.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <Winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+namespace dmitigr::pgfe::detail {
+
+/**
+ * @brief The implementation of Reactor.
+ */
+class iReactor final : public Reactor {
+public:
+  /**
+   * @brief The destructor.
+   */
+  ~iReactor() override
+  {
+#ifdef __linux__
+    if (epoll_ >= 0 && ::close(epoll_) != 0)
+      Sys_exception::report("close");
+#endif
+  }
+
+  /**
+   * @brief See Reactor::make().
+   */
+  iReactor()
+  {
+#ifdef __linux__
+    epoll_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_ < 0)
+      throw Sys_exception{"epoll_create1"};
+#endif
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  /** Non copyable. */
+  iReactor(const iReactor&) = delete;
+
+  /** Non copyable. */
+  iReactor& operator=(const iReactor&) = delete;
+
+  void add(Connection* const connection) override
+  {
+    DMITIGR_REQUIRE(connection && !has(connection), std::invalid_argument);
+    entries_[connection].connection = connection;
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  void remove(const Connection* const connection) override
+  {
+    const auto i = entries_.find(connection);
+    DMITIGR_REQUIRE(i != entries_.end(), std::invalid_argument);
+    cancel__(i->second);
+    entries_.erase(i);
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  bool has(const Connection* const connection) const override
+  {
+    return entries_.find(connection) != entries_.cend();
+  }
+
+  std::size_t size() const noexcept override
+  {
+    return entries_.size();
+  }
+
+  std::size_t pending_count() const noexcept override
+  {
+    return pending_count_;
+  }
+
+  void connect(Connection* const connection, Handler handler) override
+  {
+    auto& entry = entry__(connection);
+    DMITIGR_REQUIRE(entry.operation == Operation::none, std::logic_error);
+
+    connection->connect_async(); // can throw
+    begin__(entry, Operation::connect, std::move(handler));
+    advance__(entry, false);
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  void await_response(Connection* const connection, Handler handler) override
+  {
+    auto& entry = entry__(connection);
+    DMITIGR_REQUIRE(entry.operation == Operation::none &&
+      connection->is_connected() && connection->is_awaiting_response(), std::logic_error);
+
+    begin__(entry, Operation::await_response, std::move(handler));
+    advance__(entry, false);
+
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  bool is_pending(const Connection* const connection) const override
+  {
+    const auto i = entries_.find(connection);
+    DMITIGR_REQUIRE(i != entries_.cend(), std::invalid_argument);
+    return i->second.operation != Operation::none;
+  }
+
+  std::size_t run_once(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) override
+  {
+    DMITIGR_REQUIRE(timeout >= std::chrono::milliseconds{-1}, std::invalid_argument);
+
+    /*
+     * The operations which have been completed without I/O (for example,
+     * the response was already buffered by libpq) are dispatched first.
+     */
+    std::size_t result = dispatch_completed__();
+    if (result > 0 || pending_count_ == 0)
+      return result;
+
+    wait__(timeout); // can throw
+    for (const auto socket : ready_sockets_) {
+      if (const auto i = sockets_.find(socket); i != sockets_.end()) {
+        auto& entry = entries_.at(i->second);
+        if (entry.operation != Operation::none && !entry.is_completed)
+          advance__(entry, true); // can throw
+      }
+    }
+    result += dispatch_completed__();
+
+    DMITIGR_ASSERT(is_invariant_ok());
+    return result;
+  }
+
+  void run() override
+  {
+    while (pending_count_ > 0)
+      run_once();
+  }
+
+private:
+  enum class Operation { none, connect, await_response };
+
+  struct Entry final {
+    Connection* connection{};
+    Operation operation{Operation::none};
+    Handler handler;
+    bool is_completed{};
+    int socket{-1}; // the socket watched at the moment (-1 if none)
+    Socket_readiness readiness{Socket_readiness::unready}; // the readiness watched at the moment
+  };
+
+  bool is_invariant_ok() const
+  {
+    const bool sockets_ok = sockets_.size() <= entries_.size();
+    const bool pending_ok = pending_count_ <= entries_.size();
+    return sockets_ok && pending_ok;
+  }
+
+  Entry& entry__(const Connection* const connection)
+  {
+    const auto i = entries_.find(connection);
+    DMITIGR_REQUIRE(i != entries_.end(), std::invalid_argument);
+    return i->second;
+  }
+
+  void begin__(Entry& entry, const Operation operation, Handler&& handler)
+  {
+    entry.operation = operation;
+    entry.handler = std::move(handler);
+    entry.is_completed = false;
+    ++pending_count_;
+  }
+
+  void cancel__(Entry& entry) noexcept
+  {
+    if (entry.operation != Operation::none) {
+      DMITIGR_ASSERT_NOTHROW(pending_count_ > 0);
+      --pending_count_;
+    }
+    entry.operation = Operation::none;
+    entry.handler = {};
+    entry.is_completed = false;
+    unwatch__(entry);
+  }
+
+  /*
+   * Advances the operation of the entry. (The I/O is performed only if
+   * `is_socket_ready`.) Marks the entry as completed, or (re)arms the watch
+   * of its socket otherwise. Cancels the operation on exception.
+   */
+  void advance__(Entry& entry, const bool is_socket_ready)
+  {
+    auto* const conn = entry.connection;
+    try {
+      switch (entry.operation) {
+      case Operation::connect: {
+        if (is_socket_ready)
+          conn->connect_async(); // can throw
+        const auto status = conn->communication_status();
+        if (status == Communication_status::establishment_reading)
+          watch__(entry, Socket_readiness::read_ready);
+        else if (status == Communication_status::establishment_writing)
+          watch__(entry, Socket_readiness::write_ready);
+        else
+          complete__(entry);
+        break;
+      }
+
+      case Operation::await_response:
+        if (conn->is_connected()) {
+          conn->collect_server_messages(); // can throw
+          conn->handle_signals(); // can throw
+        }
+        if (!conn->is_connected() || conn->is_response_available() || !conn->is_awaiting_response())
+          complete__(entry);
+        else
+          watch__(entry, Socket_readiness::read_ready);
+        break;
+
+      case Operation::none:
+        DMITIGR_ASSERT_ALWAYS(!true);
+      }
+    } catch (...) {
+      cancel__(entry);
+      throw;
+    }
+  }
+
+  void complete__(Entry& entry)
+  {
+    entry.is_completed = true;
+    unwatch__(entry);
+    completed_.push_back(entry.connection);
+  }
+
+  // Returns the number of the called handlers.
+  std::size_t dispatch_completed__()
+  {
+    std::size_t result{};
+    std::vector<Connection*> completed;
+    completed.swap(completed_);
+    for (std::size_t j = 0; j < completed.size(); ++j) {
+      auto* const conn = completed[j];
+      const auto i = entries_.find(conn);
+      if (i == entries_.end() || !i->second.is_completed)
+        continue; // removed or cancelled by the handler called before
+
+      auto& entry = i->second;
+      auto handler = std::move(entry.handler);
+      entry.handler = {};
+      entry.operation = Operation::none;
+      entry.is_completed = false;
+      DMITIGR_ASSERT(pending_count_ > 0);
+      --pending_count_;
+
+      if (handler) {
+        try {
+          handler(conn); // can throw
+        } catch (...) {
+          // The rest of the completed operations will be dispatched next time.
+          completed_.insert(completed_.end(), completed.cbegin() + j + 1, completed.cend());
+          throw;
+        }
+      }
+      ++result;
+    }
+    return result;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Polling
+  // ---------------------------------------------------------------------------
+
+  static int socket__(const Connection* const connection)
+  {
+    return static_cast<const iConnection*>(connection)->socket();
+  }
+
+  void watch__(Entry& entry, const Socket_readiness readiness)
+  {
+    const int socket = socket__(entry.connection);
+    DMITIGR_ASSERT(socket >= 0);
+    if (entry.socket == socket && entry.readiness == readiness)
+      return;
+
+    // Note: libpq may switch the socket during the connection establishment.
+    if (entry.socket != socket)
+      unwatch__(entry);
+
+#ifdef __linux__
+    ::epoll_event event{};
+    event.events = (readiness == Socket_readiness::read_ready) ? EPOLLIN : EPOLLOUT;
+    event.data.fd = socket;
+    const int op = (entry.socket == socket) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (::epoll_ctl(epoll_, op, socket, &event) != 0) {
+      // The socket could be closed and reopened by libpq with the same descriptor.
+      if (!(op == EPOLL_CTL_MOD && errno == ENOENT && ::epoll_ctl(epoll_, EPOLL_CTL_ADD, socket, &event) == 0))
+        throw Sys_exception{"epoll_ctl"};
+    }
+#endif
+
+    sockets_[socket] = entry.connection;
+    entry.socket = socket;
+    entry.readiness = readiness;
+  }
+
+  void unwatch__(Entry& entry) noexcept
+  {
+    if (entry.socket < 0)
+      return;
+
+    // Note: the descriptor could be already reused by the socket of another connection.
+    if (const auto i = sockets_.find(entry.socket); i != sockets_.end() && i->second == entry.connection) {
+#ifdef __linux__
+      /*
+       * Note: the socket could be already closed by libpq (in which case it's
+       * removed from the epoll set automatically), so the errors are ignored.
+       */
+      ::epoll_event event{};
+      ::epoll_ctl(epoll_, EPOLL_CTL_DEL, entry.socket, &event);
+#endif
+      sockets_.erase(i);
+    }
+    entry.socket = -1;
+    entry.readiness = Socket_readiness::unready;
+  }
+
+  // Fills ready_sockets_ by the sockets which are ready for the watched I/O.
+  void wait__(const std::chrono::milliseconds timeout)
+  {
+    ready_sockets_.clear();
+    if (sockets_.empty())
+      return;
+
+    const int timeout_ms = static_cast<int>(std::min<std::chrono::milliseconds::rep>(timeout.count(),
+        std::numeric_limits<int>::max()));
+#ifdef __linux__
+    events_.resize(sockets_.size());
+    const int count = ::epoll_wait(epoll_, events_.data(), static_cast<int>(events_.size()), timeout_ms);
+    if (count < 0) {
+      if (errno == EINTR)
+        return;
+      else
+        throw Sys_exception{"epoll_wait"};
+    }
+    for (int i = 0; i < count; ++i)
+      ready_sockets_.push_back(events_[i].data.fd);
+#else
+    pollfds_.clear();
+    for (const auto& [socket, conn] : sockets_) {
+      const auto& entry = entries_.at(conn);
+      pollfds_.push_back({});
+      pollfds_.back().fd = static_cast<decltype (pollfds_.back().fd)>(socket);
+      pollfds_.back().events = (entry.readiness == Socket_readiness::read_ready) ? POLLIN : POLLOUT;
+    }
+#ifdef _WIN32
+    const int count = ::WSAPoll(pollfds_.data(), static_cast<ULONG>(pollfds_.size()), timeout_ms);
+    if (count == SOCKET_ERROR)
+      throw Net_exception{"WSAPoll"};
+#else
+    const int count = ::poll(pollfds_.data(), static_cast<::nfds_t>(pollfds_.size()), timeout_ms);
+    if (count < 0) {
+      if (errno == EINTR)
+        return;
+      else
+        throw Sys_exception{"poll"};
+    }
+#endif
+    for (const auto& pfd : pollfds_) {
+      if (pfd.revents)
+        ready_sockets_.push_back(static_cast<int>(pfd.fd));
+    }
+#endif
+  }
+
+  std::unordered_map<const Connection*, Entry> entries_;
+  std::unordered_map<int, Connection*> sockets_; // the watched sockets
+  std::vector<Connection*> completed_;
+  std::vector<int> ready_sockets_;
+  std::size_t pending_count_{};
+#ifdef __linux__
+  int epoll_{-1};
+  std::vector<::epoll_event> events_;
+#elif defined(_WIN32)
+  std::vector<::WSAPOLLFD> pollfds_;
+#else
+  std::vector<::pollfd> pollfds_;
+#endif
+};
+
+} // namespace dmitigr::pgfe::detail
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE std::unique_ptr<Reactor> Reactor::make()
+{
+  return std::make_unique<detail::iReactor>();
+}
+
+} // namespace dmitigr::pgfe
+
+#include "dmitigr/pgfe/implementation_footer.hpp"
@@ -0,0 +1,195 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_REACTOR_HPP
+#define DMITIGR_PGFE_REACTOR_HPP
+
+#include "dmitigr/pgfe/dll.hpp"
+#include "dmitigr/pgfe/types_fwd.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A reactor which drives the asynchronous operations on many
+ * connections from a single thread.
+ *
+ * The reactor waits for the readiness of the sockets of all the registered
+ * connections at once (by using `epoll` on Linux and `poll` elsewhere) and
+ * advances the connection establishment and the collection of the server
+ * messages for whichever connections are ready. The handler of the operation
+ * is called upon its completion.
+ *
+ * @par Example
+ * @code
+ * const auto reactor = pgfe::Reactor::make();
+ * for (auto& conn : connections) {
+ *   reactor->add(conn.get());
+ *   reactor->connect(conn.get(), [&reactor](pgfe::Connection* const conn)
+ *   {
+ *     conn->perform_async("SELECT pg_sleep(1)");
+ *     reactor->await_response(conn, [](pgfe::Connection* const conn) { conn->dismiss_response(); });
+ *   });
+ * }
+ * reactor->run(); // takes about one second regardless of the number of connections
+ * @endcode
+ *
+ * @remarks The instance of this class is not thread-safe. The registered
+ * connections must not be used by the other threads while registered.
+ */
+class Reactor {
+public:
+  /**
+   * @brief The alias of the operation completion handler.
+   */
+  using Handler = std::function<void(Connection*)>;
+
+  /**
+   * @brief The destructor.
+   */
+  virtual ~Reactor() = default;
+
+  /// @name Constructors
+  /// @{
+
+  /**
+   * @returns A new instance of this class.
+   */
+  static DMITIGR_PGFE_API std::unique_ptr<Reactor> make();
+
+  /// @}
+
+  /**
+   * @brief Registers the connection.
+   *
+   * @par Requires
+   * `(connection && !has(connection))`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The connection is not owned by the reactor and must outlive
+   * its registration.
+   */
+  virtual void add(Connection* connection) = 0;
+
+  /**
+   * @brief Unregisters the connection and cancels its pending operation (if any)
+   * without calling the handler.
+   *
+   * @par Requires
+   * `has(connection)`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  virtual void remove(const Connection* connection) = 0;
+
+  /**
+   * @returns `true` if the connection is registered, or `false` otherwise.
+   */
+  virtual bool has(const Connection* connection) const = 0;
+
+  /**
+   * @returns The number of the registered connections.
+   */
+  virtual std::size_t size() const noexcept = 0;
+
+  /**
+   * @returns The number of the pending operations.
+   */
+  virtual std::size_t pending_count() const noexcept = 0;
+
+  /**
+   * @brief Initiates (or continues) the connection establishment.
+   *
+   * @param handler - the handler which is called when the communication
+   * status of the connection becomes either Communication_status::connected
+   * or Communication_status::failure.
+   *
+   * @par Requires
+   * `(has(connection) && !is_pending(connection))`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @see Connection::connect_async().
+   */
+  virtual void connect(Connection* connection, Handler handler) = 0;
+
+  /**
+   * @brief Schedules the collection of the server messages until the response
+   * of the connection is available.
+   *
+   * @param handler - the handler which is called when either the response is
+   * available or the connection is no longer awaiting the response. The handler
+   * is called once, so it should schedule the operation again if the next
+   * response is awaited (for example, the next row).
+   *
+   * @par Requires
+   * `(has(connection) && !is_pending(connection) && connection->is_connected()
+   * && connection->is_awaiting_response())`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @see Connection::collect_server_messages(), Connection::wait_response().
+   */
+  virtual void await_response(Connection* connection, Handler handler) = 0;
+
+  /**
+   * @returns `true` if the operation of the connection is pending, or
+   * `false` otherwise.
+   *
+   * @par Requires
+   * `has(connection)`.
+   */
+  virtual bool is_pending(const Connection* connection) const = 0;
+
+  /**
+   * @brief Waits for the readiness of the sockets of the connections which have
+   * pending operations, advances these operations and calls the handlers of
+   * the completed ones.
+   *
+   * @returns The number of the handlers called.
+   *
+   * @param timeout - the maximum amount of time to wait for the readiness of
+   * any socket. The special value of `-1` denotes *eternity*.
+   *
+   * @par Requires
+   * `(timeout >= -1)`.
+   *
+   * @par Exception safety guarantee
+   * Basic. If the advancement of the operation or its handler throws, then the
+   * operation is cancelled and the exception is propagated.
+   */
+  virtual std::size_t run_once(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1}) = 0;
+
+  /**
+   * @brief Calls run_once() until `(pending_count() == 0)`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  virtual void run() = 0;
+
+private:
+  friend detail::iReactor;
+
+  Reactor() = default;
+};
+
+} // namespace dmitigr::pgfe
+
+#ifdef DMITIGR_PGFE_HEADER_ONLY
+#include "dmitigr/pgfe/reactor.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_REACTOR_HPP
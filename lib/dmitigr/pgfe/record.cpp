@@ -0,0 +1,169 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "dmitigr/pgfe/composite.hpp"
+#include "dmitigr/pgfe/data.hpp"
+#include "dmitigr/pgfe/record.hpp"
+#include "dmitigr/pgfe/implementation_header.hpp"
+
+#include <dmitigr/util/debug.hpp>
+
+#include <limits>
+#include <stdexcept>
+
+namespace dmitigr::pgfe::detail {
+
+namespace {
+
+// Reads the 4-byte integer in the network byte order.
+inline std::uint_fast32_t read_uint32(const char* const bytes) noexcept
+{
+  const auto* const ubytes = reinterpret_cast<const unsigned char*>(bytes);
+  return (std::uint_fast32_t(ubytes[0]) << 24) | (std::uint_fast32_t(ubytes[1]) << 16) |
+    (std::uint_fast32_t(ubytes[2]) << 8) | std::uint_fast32_t(ubytes[3]);
+}
+
+// Writes the 4-byte integer in the network byte order.
+inline void write_uint32(std::string& result, const std::uint_fast32_t value)
+{
+  for (int i = 3; i >= 0; --i)
+    result.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+}
+
+} // namespace
+
+/**
+ * @brief The implementation of Record.
+ */
+class iRecord final : public Record {
+public:
+  /**
+   * @brief See Record::make().
+   */
+  explicit iRecord(const Data* const data)
+  {
+    DMITIGR_REQUIRE(data && data->format() == Data_format::binary, std::invalid_argument);
+
+    /*
+     * The layout (see record_recv() of PostgreSQL):
+     *   - int32 field count;
+     *   - for each field: uint32 type OID, int32 data size (-1 for NULL), data.
+     */
+    const char* b = data->bytes();
+    const char* const e = b + data->size();
+    const auto require_bytes = [&](const std::size_t size)
+    {
+      if (std::size_t(e - b) < size)
+        throw std::runtime_error{"malformed binary record"};
+    };
+
+    require_bytes(4);
+    const auto field_count = static_cast<std::int32_t>(read_uint32(b));
+    b += 4;
+    if (field_count < 0)
+      throw std::runtime_error{"malformed binary record"};
+
+    fields_.reserve(std::size_t(field_count));
+    for (std::int32_t i = 0; i < field_count; ++i) {
+      require_bytes(8);
+      Field field;
+      field.type_oid = read_uint32(b);
+      const auto size = static_cast<std::int32_t>(read_uint32(b + 4));
+      b += 8;
+      if (size >= 0) {
+        require_bytes(std::size_t(size));
+        field.data = Data_view{b, std::size_t(size), Data_format::binary};
+        b += size;
+      } else if (size == -1)
+        field.is_null = true;
+      else
+        throw std::runtime_error{"malformed binary record"};
+      fields_.push_back(std::move(field));
+    }
+    if (b != e)
+      throw std::runtime_error{"malformed binary record"};
+  }
+
+  std::size_t field_count() const noexcept override
+  {
+    return fields_.size();
+  }
+
+  std::uint_fast32_t type_oid(const std::size_t index) const override
+  {
+    DMITIGR_REQUIRE(index < field_count(), std::out_of_range);
+    return fields_[index].type_oid;
+  }
+
+  const Data* data(const std::size_t index) const override
+  {
+    DMITIGR_REQUIRE(index < field_count(), std::out_of_range);
+    const auto& field = fields_[index];
+    return !field.is_null ? &field.data : nullptr;
+  }
+
+  std::unique_ptr<Composite> to_composite(const std::vector<std::string>& field_names = {}) const override
+  {
+    DMITIGR_REQUIRE(field_names.empty() || field_names.size() == field_count(), std::invalid_argument);
+
+    std::vector<std::pair<std::string, std::unique_ptr<Data>>> result;
+    result.reserve(fields_.size());
+    for (std::size_t i = 0; i < fields_.size(); ++i) {
+      const auto* const d = data(i);
+      result.emplace_back(field_names.empty() ? std::string{} : field_names[i],
+        d ? Data::make(d->bytes(), d->size(), Data_format::binary) : nullptr);
+    }
+    return Composite::make(std::move(result));
+  }
+
+private:
+  struct Field final {
+    std::uint_fast32_t type_oid{};
+    bool is_null{};
+    Data_view data;
+  };
+
+  std::vector<Field> fields_;
+};
+
+} // namespace dmitigr::pgfe::detail
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE std::unique_ptr<Record> Record::make(const Data* const data)
+{
+  return std::make_unique<detail::iRecord>(data);
+}
+
+DMITIGR_PGFE_INLINE std::unique_ptr<Data>
+to_record_data(const std::vector<std::pair<std::uint_fast32_t, const Data*>>& fields)
+{
+  DMITIGR_REQUIRE(fields.size() <= std::size_t(std::numeric_limits<std::int32_t>::max()),
+    std::invalid_argument);
+
+  std::size_t size{4};
+  for (const auto& [oid, data] : fields) {
+    DMITIGR_REQUIRE(!data || data->size() <= std::size_t(std::numeric_limits<std::int32_t>::max()),
+      std::invalid_argument);
+    size += 8 + (data ? data->size() : 0);
+  }
+
+  std::string result;
+  result.reserve(size);
+  detail::write_uint32(result, fields.size());
+  for (const auto& [oid, data] : fields) {
+    detail::write_uint32(result, oid);
+    if (data) {
+      detail::write_uint32(result, data->size());
+      result.append(data->bytes(), data->size());
+    } else
+      detail::write_uint32(result, 0xffffffff); // -1 denotes NULL
+  }
+  DMITIGR_ASSERT(result.size() == size);
+  return Data::make(std::move(result), Data_format::binary);
+}
+
+} // namespace dmitigr::pgfe
+
+#include "dmitigr/pgfe/implementation_footer.hpp"
@@ -0,0 +1,164 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_RECORD_HPP
+#define DMITIGR_PGFE_RECORD_HPP
+
+#include "dmitigr/pgfe/dll.hpp"
+#include "dmitigr/pgfe/row_mapper.hpp"
+#include "dmitigr/pgfe/types_fwd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A view of the value of the composite type (or `record`) in the
+ * Data_format::binary format.
+ *
+ * The fields of the record are the views into the original data, so the
+ * decoding doesn't copy the field data. The field of the nested composite
+ * type can be decoded by the other instance of this class in the same way.
+ *
+ * @par Example
+ * @code
+ * struct Person final {
+ *   int id;
+ *   std::string name;
+ * };
+ *
+ * conn->set_result_format(pgfe::Data_format::binary);
+ * conn->execute("SELECT person_by_id($1)", 1); // returns composite
+ * const auto record = pgfe::Record::make(conn->row()->data(0));
+ * const auto person = record->to<Person, int, std::string>();
+ * @endcode
+ *
+ * @remarks The binary format of the record doesn't include the field names.
+ */
+class Record {
+public:
+  /**
+   * @brief The destructor.
+   */
+  virtual ~Record() = default;
+
+  /// @name Constructors
+  /// @{
+
+  /**
+   * @returns A new instance of the view of the record.
+   *
+   * @param data - the value of the composite type in the binary format.
+   *
+   * @par Requires
+   * `(data && data->format() == Data_format::binary)`.
+   *
+   * @throws `std::runtime_error` if the `data` is malformed.
+   *
+   * @remarks The `data` must outlive the created instance.
+   */
+  static DMITIGR_PGFE_API std::unique_ptr<Record> make(const Data* data);
+
+  /// @}
+
+  /**
+   * @returns The number of fields.
+   */
+  virtual std::size_t field_count() const noexcept = 0;
+
+  /**
+   * @returns The OID of the type of the field.
+   *
+   * @par Requires
+   * `(index < field_count())`.
+   */
+  virtual std::uint_fast32_t type_oid(std::size_t index) const = 0;
+
+  /**
+   * @returns The data of the field in the Data_format::binary format, or
+   * `nullptr` if NULL.
+   *
+   * @par Requires
+   * `(index < field_count())`.
+   *
+   * @remarks The returned data is the view into the original data.
+   */
+  virtual const Data* data(std::size_t index) const = 0;
+
+  /**
+   * @returns The copy of the record as Composite with the specified names of
+   * the fields (or with the empty names if `field_names` is empty).
+   *
+   * @par Requires
+   * `(field_names.empty() || field_names.size() == field_count())`.
+   */
+  virtual std::unique_ptr<Composite> to_composite(const std::vector<std::string>& field_names = {}) const = 0;
+
+  /**
+   * @returns The tuple of converted fields of the record.
+   *
+   * @par Requires
+   * `(field_count() >= sizeof...(Types))`.
+   *
+   * @see Row_mapper.
+   */
+  template<typename ... Types>
+  std::tuple<Types...> to_tuple() const
+  {
+    DMITIGR_REQUIRE(field_count() >= sizeof...(Types), std::logic_error);
+    return to_tuple__<Types...>(std::index_sequence_for<Types...>{});
+  }
+
+  /**
+   * @returns The value of type `T` initialized by the elements of the result
+   * of `to_tuple<Types...>()` by using the braced initialization.
+   */
+  template<class T, typename ... Types>
+  T to() const
+  {
+    return std::apply([](auto&& ... elements) { return T{std::move(elements)...}; },
+      to_tuple<Types...>());
+  }
+
+private:
+  friend detail::iRecord;
+
+  Record() = default;
+
+  template<typename ... Types, std::size_t ... I>
+  std::tuple<Types...> to_tuple__(std::index_sequence<I...>) const
+  {
+    return std::tuple<Types...>{detail::Field_conversions<Types>::to_type(data(I))...};
+  }
+};
+
+/**
+ * @ingroup main
+ *
+ * @returns The value of the composite type in the Data_format::binary format
+ * which is composed of the `fields`. Each field is the pair of the OID of its
+ * type and its data in the binary format of this type, or `nullptr` for NULL.
+ *
+ * @par Requires
+ * The size of each data must not exceed the maximum value of `std::int32_t`.
+ *
+ * @relates Record
+ */
+DMITIGR_PGFE_API std::unique_ptr<Data> to_record_data(const std::vector<std::pair<std::uint_fast32_t, const Data*>>& fields);
+
+} // namespace dmitigr::pgfe
+
+#ifdef DMITIGR_PGFE_HEADER_ONLY
+#include "dmitigr/pgfe/record.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_RECORD_HPP
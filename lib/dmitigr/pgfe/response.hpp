@@ -17,9 +17,11 @@ namespace dmitigr::pgfe {
 class Response : public Server_message {
 private:
   friend Completion;
+  friend Copier;
   friend Error;
   friend Prepared_statement;
   friend Row;
+  friend Row_set;
 
   Response() = default;
 };
@@ -8,6 +8,10 @@
 #include "dmitigr/pgfe/row_info.hpp"
 #include "dmitigr/pgfe/implementation_header.hpp"
 
+#include <dmitigr/util/memory.hpp>
+
+#include <vector>
+
 namespace dmitigr::pgfe::detail {
 
 /**
@@ -31,20 +35,54 @@ class pq_Row final : public iRow {
 public:
   /**
    * @brief The constructor.
+   *
+   * @param storage - the storage for the data of the fields. (Its capacity
+   * is reused if enough.)
    */
-  explicit pq_Row(pq_Row_info&& info)
+  explicit pq_Row(pq_Row_info&& info, std::vector<Data_view>&& storage = {})
     : info_{std::move(info)}
-    , datas_{decltype (datas_)::size_type(info_.pq_result_.field_count())}
+    , datas_{std::move(storage)}
   {
     const auto& pq_result = info_.pq_result_;
     const int fc = pq_result.field_count();
     DMITIGR_ASSERT(fc >= 0);
+    datas_.clear();
+    datas_.reserve(std::size_t(fc));
     for (int f = 0; f < fc; ++f)
-      datas_[f] = Data_view(pq_result.data_value(0, f),
+      datas_.emplace_back(pq_result.data_value(0, f),
         std::size_t(pq_result.data_size(0, f)), pq_result.field_format(f));
     DMITIGR_ASSERT(is_invariant_ok());
   }
 
+  /**
+   * @brief Allocates the memory for the instance from the pool.
+   */
+  static void* operator new(const std::size_t size)
+  {
+    DMITIGR_ASSERT(size == sizeof(pq_Row));
+    return memory::Block_pool<sizeof(pq_Row)>::allocate();
+  }
+
+  /**
+   * @brief Returns the memory occupied by the instance back to the pool.
+   */
+  static void operator delete(void* const ptr) noexcept
+  {
+    memory::Block_pool<sizeof(pq_Row)>::deallocate(ptr);
+  }
+
+  /**
+   * @returns The storage for the data of the fields in order to reuse it
+   * for another row.
+   *
+   * @par Effects
+   * The instance is unusable.
+   */
+  std::vector<Data_view> release_storage() noexcept
+  {
+    return std::move(datas_);
+  }
+
   // ---------------------------------------------------------------------------
   // Compositional overridings
   // ---------------------------------------------------------------------------
@@ -10,11 +10,126 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <vector>
 #include <type_traits>
 
 namespace dmitigr::pgfe::detail {
 
+/**
+ * @brief The field names which are shared across multiple rows of the result.
+ *
+ * The index for the lookup of the fields by names is built once, at the
+ * construction of the instance.
+ */
+class Field_names final {
+public:
+  /**
+   * @brief The constructor.
+   */
+  explicit Field_names(const pq::Result& pq_result)
+  {
+    DMITIGR_ASSERT(pq_result);
+    const int fc = pq_result.field_count();
+    names_.reserve(std::size_t(fc));
+    for (int i = 0; i < fc; ++i)
+      names_.emplace_back(pq_result.field_name(i));
+
+    // The linear search is faster for just a few fields.
+    if (names_.size() > linear_search_threshold_) {
+      sorted_positions_.resize(names_.size());
+      std::iota(begin(sorted_positions_), end(sorted_positions_), std::size_t{0});
+      std::stable_sort(begin(sorted_positions_), end(sorted_positions_),
+        [this](const std::size_t lhs, const std::size_t rhs) { return names_[lhs] < names_[rhs]; });
+    }
+  }
+
+  /**
+   * @returns The number of fields.
+   */
+  std::size_t size() const noexcept
+  {
+    return names_.size();
+  }
+
+  /**
+   * @returns `true` if there are no fields, or `false` otherwise.
+   */
+  bool empty() const noexcept
+  {
+    return names_.empty();
+  }
+
+  /**
+   * @returns The name of the field at the `index`.
+   */
+  const std::string& operator[](const std::size_t index) const noexcept
+  {
+    DMITIGR_ASSERT_NOTHROW(index < size());
+    return names_[index];
+  }
+
+  /**
+   * @returns `true` if the field names of `pq_result` are the same as of
+   * this instance, or `false` otherwise.
+   */
+  bool is_matching(const pq::Result& pq_result) const noexcept
+  {
+    DMITIGR_ASSERT_NOTHROW(pq_result);
+    const int fc = pq_result.field_count();
+    if (std::size_t(fc) != size())
+      return false;
+
+    for (int i = 0; i < fc; ++i) {
+      if (names_[std::size_t(i)] != pq_result.field_name(i))
+        return false;
+    }
+    return true;
+  }
+
+  /**
+   * @returns The index of the first field with the specified `name` starting
+   * from the `offset`, or `size()` if there is no such a field.
+   *
+   * @par Requires
+   * `(offset < size())`.
+   */
+  std::size_t index(const std::string& name, const std::size_t offset) const
+  {
+    DMITIGR_ASSERT(offset < size());
+
+    // The identifiers without quotes, uppercase and non-ASCII letters are unchanged by unquoting.
+    const bool is_unquoting_required = std::any_of(cbegin(name), cend(name), [](const char c)
+    {
+      return c == '"' || ('A' <= c && c <= 'Z') || static_cast<unsigned char>(c) >= 0x80;
+    });
+    return is_unquoting_required ? index__(unquote_identifier(name), offset) : index__(name, offset);
+  }
+
+private:
+  constexpr static std::size_t linear_search_threshold_{8};
+  std::vector<std::string> names_;
+  std::vector<std::size_t> sorted_positions_; // sorted by names, then by positions
+
+  std::size_t index__(const std::string& ident, const std::size_t offset) const
+  {
+    if (sorted_positions_.empty()) {
+      const auto b = cbegin(names_);
+      const auto i = std::find(b + offset, cend(names_), ident);
+      return i - b;
+    }
+
+    const auto e = cend(sorted_positions_);
+    const auto i = std::lower_bound(cbegin(sorted_positions_), e, ident,
+      [this, offset](const std::size_t position, const std::string& value)
+      {
+        const int cmp = names_[position].compare(value);
+        return cmp < 0 || (cmp == 0 && position < offset);
+      });
+    return (i != e && names_[*i] == ident) ? *i : size();
+  }
+};
+
 /**
  * @brief The base implementation of Row_info.
  */
@@ -93,7 +208,7 @@ public:
    * @overload
    */
   pq_Row_info(pq::Result&& pq_result,
-    const std::shared_ptr<std::vector<std::string>>& shared_field_names)
+    const std::shared_ptr<const Field_names>& shared_field_names)
     : pq_result_(std::move(pq_result))
     , shared_field_names_(shared_field_names)
   {
@@ -117,17 +232,11 @@ public:
   pq_Row_info& operator=(pq_Row_info&&) = default;
 
   /**
-   * @returns The shared vector of field names to use across multiple rows.
+   * @returns The shared field names to use across multiple rows.
    */
-  static std::shared_ptr<std::vector<std::string>> make_shared_field_names(const pq::Result& pq_result)
+  static std::shared_ptr<const Field_names> make_shared_field_names(const pq::Result& pq_result)
   {
-    DMITIGR_ASSERT(pq_result);
-    auto result = std::make_shared<std::vector<std::string>>(pq_result.field_count());
-    const auto fc = pq_result.field_count();
-    using Counter = std::remove_const_t<decltype (fc)>;
-    for (Counter i = 0; i < fc; ++i)
-      (*result)[i] = pq_result.field_name(i);
-    return result;
+    return std::make_shared<const Field_names>(pq_result);
   }
 
   // ---------------------------------------------------------------------------
@@ -226,16 +335,7 @@ protected:
       (shared_field_names_->size() - 1 <= std::numeric_limits<int>::max()) &&
       (shared_field_names_->size() == std::size_t(pq_result_.field_count()));
 
-    const bool field_names_ok = [this]()
-    {
-      const auto fc = field_count();
-      using Counter = std::remove_const_t<decltype (fc)>;
-      for (Counter i = 0; i < fc; ++i) {
-        if (pq_result_.field_name(int(i)) != (*shared_field_names_)[i])
-          return false;
-      }
-      return true;
-    }();
+    const bool field_names_ok = shared_field_names_ && shared_field_names_->is_matching(pq_result_);
 
     const bool irow_info_ok = iRow_info::is_invariant_ok();
 
@@ -244,20 +344,16 @@ protected:
 
 private:
   friend pq_Row;
+  friend pq_Row_set;
   friend pq_Prepared_statement;
 
   std::size_t field_index__(const std::string& name, std::size_t offset) const
   {
-    DMITIGR_ASSERT(offset < field_count());
-    const auto b = cbegin(*shared_field_names_);
-    const auto e = cend(*shared_field_names_);
-    const auto ident = unquote_identifier(name);
-    const auto i = std::find(b + offset, e, ident);
-    return i - b;
+    return shared_field_names_->index(name, offset);
   }
 
   pq::Result pq_result_;
-  std::shared_ptr<std::vector<std::string>> shared_field_names_;
+  std::shared_ptr<const Field_names> shared_field_names_;
 };
 
 } // namespace dmitigr::pgfe::detail
@@ -0,0 +1,258 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_ROW_MAPPER_HPP
+#define DMITIGR_PGFE_ROW_MAPPER_HPP
+
+#include "dmitigr/pgfe/conversions.hpp"
+#include "dmitigr/pgfe/row.hpp"
+#include "dmitigr/pgfe/row_info.hpp"
+#include "dmitigr/pgfe/row_set.hpp"
+#include "dmitigr/pgfe/types_fwd.hpp"
+
+#include <dmitigr/util/debug.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace dmitigr::pgfe {
+
+namespace detail {
+
+/**
+ * @brief The conversion of the field data to the value of type `T`.
+ */
+template<typename T>
+struct Field_conversions final {
+  static T to_type(const Data* const data)
+  {
+    if (!data)
+      throw std::runtime_error{"cannot convert NULL to the value of non-optional type"};
+    return Conversions<T>::to_type(data);
+  }
+};
+
+/**
+ * @brief The partial specialization of Field_conversions for `std::optional<T>`.
+ */
+template<typename T>
+struct Field_conversions<std::optional<T>> final {
+  static std::optional<T> to_type(const Data* const data)
+  {
+    return data ? std::make_optional(Conversions<T>::to_type(data)) : std::nullopt;
+  }
+};
+
+/**
+ * @brief The trait to detect `std::tuple`.
+ */
+template<typename T>
+struct Is_tuple final : std::false_type {};
+
+/**
+ * @brief The partial specialization of Is_tuple for `std::tuple`.
+ */
+template<typename ... Types>
+struct Is_tuple<std::tuple<Types...>> final : std::true_type {
+  using Mapper = Row_mapper<Types...>;
+};
+
+} // namespace detail
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The converter of rows to the tuples of type `std::tuple<Types...>`
+ * (or to the aggregates of the same structure).
+ *
+ * The field of the row is converted by using the specialization of the struct
+ * template Conversions which is choosen at compile time. The fields of type
+ * `std::optional<T>` are converted to `std::nullopt` when NULL.
+ *
+ * When the fields are mapped by names, the positions of fields are resolved
+ * once and reused for the following rows with the same field names. (Which is
+ * checked by comparing the field names at the resolved positions only.)
+ *
+ * @par Example
+ * @code
+ * struct Person final {
+ *   int id;
+ *   std::string name;
+ *   std::optional<int> age;
+ * };
+ *
+ * pgfe::Row_mapper<int, std::string, std::optional<int>> mapper{{"id", "name", "age"}};
+ * conn->execute("SELECT name, age, id FROM person");
+ * while (const auto* const row = conn->row()) {
+ *   const auto person = mapper.to<Person>(row);
+ *   // ...
+ *   conn->dismiss_response();
+ *   conn->wait_response();
+ * }
+ * @endcode
+ *
+ * @remarks The instance of this class is not thread-safe.
+ */
+template<typename ... Types>
+class Row_mapper final {
+public:
+  /**
+   * @brief The alias of the tuple type.
+   */
+  using Tuple = std::tuple<Types...>;
+
+  /**
+   * @brief The number of mapped fields.
+   */
+  static constexpr std::size_t field_count = sizeof...(Types);
+
+  /**
+   * @brief The alias of the array of field names.
+   */
+  using Field_names = std::array<std::string, field_count>;
+
+  /**
+   * @brief The constructor of the mapper of the fields by their indexes.
+   *
+   * The field with the index `i` is mapped to the `i`-th element of the tuple.
+   */
+  Row_mapper() = default;
+
+  /**
+   * @brief The constructor of the mapper of the fields by their names.
+   *
+   * The field with the name `field_names[i]` is mapped to the `i`-th element
+   * of the tuple.
+   */
+  explicit Row_mapper(Field_names field_names)
+    : field_names_{std::move(field_names)}
+  {}
+
+  /**
+   * @returns The names of the mapped fields, or `nullptr` if the fields are
+   * mapped by their indexes.
+   */
+  const Field_names* field_names() const noexcept
+  {
+    return field_names_ ? &*field_names_ : nullptr;
+  }
+
+  /**
+   * @returns The tuple of converted fields of the `row`.
+   *
+   * @par Requires
+   * `(row)`, and `(row->field_count() >= field_count)` if the fields are mapped
+   * by their indexes, or `row->has_field(field_names()[i])` for each `i` in
+   * `[0, field_count)` otherwise.
+   */
+  Tuple to_tuple(const Row* const row)
+  {
+    DMITIGR_REQUIRE(row, std::invalid_argument);
+    resolve(*row);
+    return to_tuple__([row](const std::size_t index) { return row->data(index); },
+      std::index_sequence_for<Types...>{});
+  }
+
+  /**
+   * @overload
+   *
+   * @param rows - the set of rows;
+   * @param row - the index of the row in the `rows`.
+   *
+   * @par Requires
+   * `(rows && row < rows->row_count())` plus the requirements of the fields
+   * like above applied to `rows->info()`.
+   */
+  Tuple to_tuple(const Row_set* const rows, const std::size_t row)
+  {
+    DMITIGR_REQUIRE(rows && row < rows->row_count(), std::invalid_argument);
+    resolve(*rows->info());
+    return to_tuple__([rows, row](const std::size_t index) { return rows->data(row, index); },
+      std::index_sequence_for<Types...>{});
+  }
+
+  /**
+   * @returns The value of type `T` initialized by the elements of the result
+   * of `to_tuple(args...)` by using the braced initialization.
+   */
+  template<class T, typename ... Args>
+  T to(Args&& ... args)
+  {
+    return std::apply([](auto&& ... elements) { return T{std::move(elements)...}; },
+      to_tuple(std::forward<Args>(args)...));
+  }
+
+private:
+  std::optional<Field_names> field_names_;
+  std::array<std::size_t, field_count> positions_{};
+  bool is_resolved_{};
+
+  template<class Compositional, std::size_t ... I>
+  void resolve__(const Compositional& compositional, std::index_sequence<I...>)
+  {
+    ((positions_[I] = compositional.field_index_throw((*field_names_)[I])), ...);
+  }
+
+  template<class Compositional>
+  void resolve(const Compositional& compositional)
+  {
+    if (!field_names_) {
+      DMITIGR_REQUIRE(compositional.field_count() >= field_count, std::invalid_argument);
+      if (!is_resolved_) {
+        for (std::size_t i = 0; i < field_count; ++i)
+          positions_[i] = i;
+        is_resolved_ = true;
+      }
+    } else if (!is_resolved_ || !is_resolved_for(compositional)) {
+      is_resolved_ = false;
+      resolve__(compositional, std::index_sequence_for<Types...>{}); // can throw
+      is_resolved_ = true;
+    }
+  }
+
+  template<class Compositional>
+  bool is_resolved_for(const Compositional& compositional) const
+  {
+    DMITIGR_ASSERT(field_names_ && is_resolved_);
+    const auto count = compositional.field_count();
+    for (std::size_t i = 0; i < field_count; ++i) {
+      const auto position = positions_[i];
+      if (position >= count || compositional.field_name(position) != (*field_names_)[i])
+        return false;
+    }
+    return true;
+  }
+
+  template<class DataGetter, std::size_t ... I>
+  Tuple to_tuple__(const DataGetter& data, std::index_sequence<I...>) const
+  {
+    return Tuple{detail::Field_conversions<Types>::to_type(data(positions_[I]))...};
+  }
+};
+
+/**
+ * @ingroup conversions
+ *
+ * @returns The tuple of converted fields of the `row` which are mapped to the
+ * elements of the tuple by their indexes.
+ *
+ * @tparam T - the type `std::tuple<Types...>`.
+ *
+ * @see Row_mapper.
+ */
+template<typename T>
+inline std::enable_if_t<detail::Is_tuple<T>::value, T> to(const Row* const row)
+{
+  return typename detail::Is_tuple<T>::Mapper{}.to_tuple(row);
+}
+
+} // namespace dmitigr::pgfe
+
+#endif  // DMITIGR_PGFE_ROW_MAPPER_HPP
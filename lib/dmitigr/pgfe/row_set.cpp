@@ -0,0 +1,104 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "dmitigr/pgfe/data.hpp"
+#include "dmitigr/pgfe/row_info.hpp"
+#include "dmitigr/pgfe/row_set.hpp"
+#include "dmitigr/pgfe/implementation_header.hpp"
+
+#include <vector>
+
+namespace dmitigr::pgfe::detail {
+
+/**
+ * @brief The base implementation of Row_set.
+ */
+class iRow_set : public Row_set {
+protected:
+  virtual bool is_invariant_ok() = 0;
+};
+
+inline bool iRow_set::is_invariant_ok()
+{
+  const bool info_ok = info() != nullptr;
+  return info_ok;
+}
+
+/**
+ * @brief The implementation of Row_set based on libpq.
+ */
+class pq_Row_set final : public iRow_set {
+public:
+  /**
+   * @brief The constructor.
+   *
+   * @remarks The views to the data of all of the rows are created at once,
+   * so the whole set requires only one extra memory allocation.
+   */
+  explicit pq_Row_set(pq_Row_info&& info)
+    : info_{std::move(info)}
+    , datas_{decltype (datas_)::size_type(info_.pq_result_.row_count()) * info_.field_count()}
+  {
+    const auto& pq_result = info_.pq_result_;
+    const int rc = pq_result.row_count();
+    const int fc = pq_result.field_count();
+    DMITIGR_ASSERT(rc >= 0 && fc >= 0);
+    for (int r = 0, i = 0; r < rc; ++r) {
+      for (int f = 0; f < fc; ++f, ++i)
+        datas_[i] = Data_view(pq_result.data_value(r, f),
+          std::size_t(pq_result.data_size(r, f)), pq_result.field_format(f));
+    }
+    DMITIGR_ASSERT(is_invariant_ok());
+  }
+
+  // ---------------------------------------------------------------------------
+  // Row_set overridings
+  // ---------------------------------------------------------------------------
+
+  const pq_Row_info* info() const noexcept override
+  {
+    return &info_;
+  }
+
+  std::size_t row_count() const noexcept override
+  {
+    return static_cast<std::size_t>(info_.pq_result_.row_count());
+  }
+
+  const Data_view* data(const std::size_t row, const std::size_t field) const override
+  {
+    DMITIGR_REQUIRE(row < row_count() && field < info_.field_count(), std::out_of_range);
+    return data__(row, field);
+  }
+
+  const Data_view* data(const std::size_t row, const std::string& name, const std::size_t offset) const override
+  {
+    DMITIGR_REQUIRE(row < row_count(), std::out_of_range);
+    const auto field = info_.field_index_throw(name, offset);
+    return data__(row, field);
+  }
+
+protected:
+  bool is_invariant_ok() override
+  {
+    const bool datas_ok = (row_count() * info_.field_count() == datas_.size());
+    const bool status_ok = (info_.pq_result_.status() == PGRES_TUPLES_OK);
+    const bool irow_set_ok = iRow_set::is_invariant_ok();
+    return datas_ok && status_ok && irow_set_ok;
+  }
+
+private:
+  const Data_view* data__(const std::size_t row, const std::size_t field) const noexcept
+  {
+    return !info_.pq_result_.is_data_null(int(row), int(field)) ?
+      &datas_[row * info_.field_count() + field] : nullptr;
+  }
+
+  pq_Row_info info_; // contains pq::Result
+  std::vector<Data_view> datas_;
+};
+
+} // namespace dmitigr::pgfe::detail
+
+#include "dmitigr/pgfe/implementation_footer.hpp"
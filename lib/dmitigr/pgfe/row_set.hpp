@@ -0,0 +1,72 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#ifndef DMITIGR_PGFE_ROW_SET_HPP
+#define DMITIGR_PGFE_ROW_SET_HPP
+
+#include "dmitigr/pgfe/response.hpp"
+
+#include <string>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A set of rows produced by a PostgreSQL server at once.
+ *
+ * @remarks The set of rows is the response to the query executed in
+ * the Row_processing::batch mode.
+ *
+ * @see Connection::set_row_processing().
+ */
+class Row_set : public Response {
+public:
+  /**
+   * @returns The information about the rows of this set.
+   */
+  virtual const Row_info* info() const noexcept = 0;
+
+  /**
+   * @returns The number of rows in this set.
+   */
+  virtual std::size_t row_count() const noexcept = 0;
+
+  /**
+   * @returns The data of the field of the specified row of this set, or
+   * `nullptr` if NULL.
+   *
+   * @param row - the row index;
+   * @param field - the field index.
+   *
+   * @par Requires
+   * `(row < row_count() && field < info()->field_count())`.
+   */
+  virtual const Data* data(std::size_t row, std::size_t field) const = 0;
+
+  /**
+   * @overload
+   *
+   * @param row - the row index;
+   * @param name - see Compositional;
+   * @param offset - see Compositional.
+   *
+   * @par Requires
+   * `(row < row_count() && info()->has_field(name, offset))`.
+   */
+  virtual const Data* data(std::size_t row, const std::string& name, std::size_t offset = 0) const = 0;
+
+private:
+  friend detail::iRow_set;
+
+  Row_set() = default;
+};
+
+} // namespace dmitigr::pgfe
+
+#ifdef DMITIGR_PGFE_HEADER_ONLY
+#include "dmitigr/pgfe/row_set.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_ROW_SET_HPP
@@ -11,10 +11,13 @@
 #include <dmitigr/util/debug.hpp>
 
 #include <algorithm>
-#include <list>
+#include <charconv>
 #include <locale>
+#include <map>
 #include <optional>
 #include <stdexcept>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -22,6 +25,52 @@ namespace dmitigr::pgfe::detail {
 
 std::pair<iSql_string, const char*> parse_sql_input(const char* text);
 
+namespace {
+
+/**
+ * @returns `true` if `c` is a space character.
+ *
+ * @remarks ASCII characters are classified without using the locale.
+ */
+inline bool is_space_char(const char c)
+{
+  if (static_cast<unsigned char>(c) < 0x80)
+    return c == ' ' || ('\t' <= c && c <= '\r');
+  else
+    return std::isspace(c, std::locale{});
+}
+
+/**
+ * @returns `true` if `c` is a decimal digit.
+ */
+inline bool is_digit_char(const char c) noexcept
+{
+  return '0' <= c && c <= '9';
+}
+
+/**
+ * @returns `true` if `c` is a letter or a decimal digit.
+ *
+ * @remarks ASCII characters are classified without using the locale.
+ */
+inline bool is_alnum_char(const char c)
+{
+  if (static_cast<unsigned char>(c) < 0x80)
+    return is_digit_char(c) || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+  else
+    return std::isalnum(c, std::locale{});
+}
+
+/**
+ * @returns `true` if `c` is a valid character of unquoted SQL identifier.
+ */
+inline bool is_ident_char(const char c)
+{
+  return (is_alnum_char(c) || c == '_' || c == '$');
+}
+
+} // namespace
+
 /**
  * @brief The implementation of Sql_string.
  */
@@ -57,11 +106,13 @@ public:
    * @brief The copy constructor.
    */
   iSql_string(const iSql_string& rhs)
-    : fragments_{rhs.fragments_}
+    : text_{rhs.text_}
+    , fragments_{rhs.fragments_}
+    , fragments_size_{rhs.fragments_size_}
     , positional_parameters_{rhs.positional_parameters_}
-  {
-    named_parameters_ = named_parameters();
-  }
+    , named_parameters_{rhs.named_parameters_}
+    , query_string_{rhs.query_string_}
+  {}
 
   /**
    * @brief The copy assignment operator.
@@ -77,11 +128,13 @@ public:
    * @brief The move constructor.
    */
   iSql_string(iSql_string&& rhs)
-    : fragments_{std::move(rhs.fragments_)}
+    : text_{std::move(rhs.text_)}
+    , fragments_{std::move(rhs.fragments_)}
+    , fragments_size_{rhs.fragments_size_}
     , positional_parameters_{std::move(rhs.positional_parameters_)}
-  {
-    named_parameters_ = named_parameters();
-  }
+    , named_parameters_{std::move(rhs.named_parameters_)}
+    , query_string_{std::move(rhs.query_string_)}
+  {}
 
   /**
    * @brief The move assignment operator.
@@ -98,9 +151,12 @@ public:
    */
   void swap(iSql_string& other)
   {
+    text_.swap(other.text_);
     fragments_.swap(other.fragments_);
+    std::swap(fragments_size_, other.fragments_size_);
     positional_parameters_.swap(other.positional_parameters_);
     named_parameters_.swap(other.named_parameters_);
+    query_string_.swap(other.query_string_);
   }
 
   std::size_t positional_parameter_count() const override
@@ -121,7 +177,7 @@ public:
   const std::string& parameter_name(const std::size_t index) const override
   {
     DMITIGR_ASSERT(positional_parameter_count() <= index && index < parameter_count());
-    return (named_parameters_[index - positional_parameter_count()])->str;
+    return named_parameters_[index - positional_parameter_count()];
   }
 
   std::optional<std::size_t> parameter_index(const std::string& name) const override
@@ -173,9 +229,9 @@ public:
   bool is_query_empty() const noexcept override
   {
     return std::all_of(cbegin(fragments_), cend(fragments_),
-      [](const Fragment& f)
+      [this](const Fragment& f)
       {
-        return is_comment(f) || (is_text(f) && is_blank_string(f.str));
+        return is_comment(f) || (is_text(f) && is_blank_string(f.str(text_)));
       });
   }
 
@@ -199,16 +255,26 @@ public:
 
     const bool was_query_empty = is_query_empty();
 
+    // The named parameters of the `appendix` follow the named parameters of this instance.
+    auto splice = named_parameters_.prepare_splice(named_parameters_.size(), 0, iappendix->named_parameters_);
+
     // Updating fragments
-    auto old_fragments = fragments_;
+    const auto old_text_size = text_.size();
+    const auto old_fragment_count = fragments_.size();
+    const auto appendix_fragments_size = iappendix->fragments_size_;
     try {
-      fragments_.insert(cend(fragments_), cbegin(iappendix->fragments_), cend(iappendix->fragments_));
-      update_cache(*iappendix); // can throw (strong exception safety guarantee)
+      text_.append(iappendix->text_);
+      fragments_.reserve(old_fragment_count + iappendix->fragments_.size());
+      for (const auto& fragment : iappendix->fragments_)
+        fragments_.push_back(fragment.shifted(old_text_size));
+      update_cache(*iappendix, std::move(splice)); // can throw (strong exception safety guarantee)
+      fragments_size_ += appendix_fragments_size;
 
       if (was_query_empty)
         is_extra_data_should_be_extracted_from_comments_ = true;
     } catch (...) {
-      fragments_.swap(old_fragments); // rollback
+      fragments_.resize(old_fragment_count); // rollback
+      text_.resize(old_text_size); // rollback
       throw;
     }
 
@@ -228,22 +294,88 @@ public:
     const auto* const ireplacement = dynamic_cast<const iSql_string*>(replacement);
     DMITIGR_ASSERT_ALWAYS(ireplacement);
 
+    // The unreferenced bytes are released before the text of the `replacement` is appended.
+    if (text_.size() > 2 * fragments_size_)
+      compact_text(); // can throw (strong exception safety guarantee)
+
+    /*
+     * The named parameters which precedes the replaced one are unaffected. The
+     * named parameters of the `replacement` takes the place of the replaced one
+     * (unless they precedes it). The rest of the named parameters follows them.
+     */
+    auto splice = named_parameters_.prepare_splice(named_parameters_.index(name), 1, ireplacement->named_parameters_);
+
+    // The positions of the fragments to replace.
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i < fragments_.size(); ++i) {
+      const auto& fragment = fragments_[i];
+      if (fragment.type == Fragment::Type::named_parameter && fragment.str(text_) == name)
+        positions.push_back(i);
+    }
+    DMITIGR_ASSERT(!positions.empty());
+
+    // The empty text fragments of the `replacement` are omitted unless they separate the comments.
+    Fragment_vector rfragments;
+    {
+      const auto& ifragments = ireplacement->fragments_;
+      rfragments.reserve(ifragments.size());
+      for (std::size_t i = 0; i < ifragments.size(); ++i) {
+        const auto& fragment = ifragments[i];
+        if (!is_text(fragment) || fragment.size > 0 ||
+          (0 < i && i + 1 < ifragments.size() && is_comment(ifragments[i - 1]) && is_comment(ifragments[i + 1])))
+          rfragments.push_back(fragment);
+      }
+    }
+    const auto new_fragments_size = fragments_size_ +
+      positions.size() * ireplacement->fragments_size_ - positions.size() * name.size();
+
     // Updating fragments
-    auto old_fragments = fragments_;
+    const auto old_text_size = text_.size();
     try {
-      for (auto fi = begin(fragments_); fi != end(fragments_);) {
-        if (fi->type == Fragment::Type::named_parameter && fi->str == name) {
-          // Firstly, we'll insert the `replacement` just before `fi`.
-          fragments_.insert(fi, cbegin(ireplacement->fragments_), cend(ireplacement->fragments_));
-          // Secondly, we'll erase named parameter pointed by `fi` and got the next iterator.
-          fi = fragments_.erase(fi);
-        } else
-          ++fi;
+      // The text of the `replacement` is stored once and shared by all of its insertions.
+      if (rfragments.size() == 1) {
+        // The affected fragments are updated in place.
+        const auto rfragment = rfragments.front().shifted(old_text_size);
+        Fragment_vector replaced_fragments;
+        replaced_fragments.reserve(positions.size());
+        text_.append(ireplacement->text_);
+        for (const auto p : positions) {
+          replaced_fragments.push_back(fragments_[p]);
+          fragments_[p] = rfragment;
+        }
+        try {
+          update_cache(*ireplacement, std::move(splice)); // can throw (strong exception safety guarantee)
+        } catch (...) {
+          for (std::size_t i = 0; i < positions.size(); ++i)
+            fragments_[positions[i]] = replaced_fragments[i]; // rollback
+          throw;
+        }
+      } else {
+        Fragment_vector new_fragments;
+        new_fragments.reserve(fragments_.size() - positions.size() + positions.size() * rfragments.size());
+        text_.append(ireplacement->text_);
+        auto first = cbegin(fragments_);
+        for (const auto p : positions) {
+          const auto replaced = cbegin(fragments_) + p;
+          new_fragments.insert(cend(new_fragments), first, replaced);
+          for (const auto& rfragment : rfragments)
+            new_fragments.push_back(rfragment.shifted(old_text_size));
+          first = replaced + 1;
+        }
+        new_fragments.insert(cend(new_fragments), first, cend(fragments_));
+
+        Fragment_vector old_fragments{std::move(new_fragments)};
+        fragments_.swap(old_fragments);
+        try {
+          update_cache(*ireplacement, std::move(splice)); // can throw (strong exception safety guarantee)
+        } catch (...) {
+          fragments_.swap(old_fragments); // rollback
+          throw;
+        }
       }
-
-      update_cache(*ireplacement);  // can throw (strong exception safety guarantee)
+      fragments_size_ = new_fragments_size;
     } catch (...) {
-      fragments_.swap(old_fragments);
+      text_.resize(old_text_size); // rollback
       throw;
     }
 
@@ -259,62 +391,51 @@ public:
   std::string to_string() const override
   {
     std::string result;
-    result.reserve(512);
+    result.reserve(text_.size() + 4 * fragments_.size());
     for (const auto& fragment : fragments_) {
+      const auto str = fragment.str(text_);
       switch (fragment.type) {
       case Fragment::Type::text:
-        result += fragment.str;
+        result += str;
         break;
       case Fragment::Type::one_line_comment:
         result += "--";
-        result += fragment.str;
+        result += str;
         result += '\n';
         break;
       case Fragment::Type::multi_line_comment:
         result += "/*";
-        result += fragment.str;
+        result += str;
         result += "*/";
         break;
       case Fragment::Type::named_parameter:
         result += ':';
-        result += fragment.str;
+        result += str;
         break;
       case Fragment::Type::positional_parameter:
         result += '$';
-        result += fragment.str;
+        result += str;
         break;
       }
     }
-    result.shrink_to_fit();
     return result;
   }
 
   std::string to_query_string() const override
   {
-    std::string result;
-    result.reserve(512);
-    for (const auto& fragment : fragments_) {
-      switch (fragment.type) {
-      case Fragment::Type::text:
-        result += fragment.str;
-        break;
-      case Fragment::Type::one_line_comment:
-      case Fragment::Type::multi_line_comment:
-        break;
-      case Fragment::Type::named_parameter: {
-        const auto idx = named_parameter_index__(fragment.str);
-        DMITIGR_ASSERT(idx < parameter_count());
-        result += '$';
-        result += std::to_string(idx + 1);
-        break;
-      }
-      case Fragment::Type::positional_parameter:
-        result += '$';
-        result += fragment.str;
-        break;
-      }
-    }
-    return result;
+    return query_string_;
+  }
+
+  /**
+   * @returns The result of to_query_string() which is rendered upon the
+   * parsing and upon each modification of this instance.
+   *
+   * @remarks Since the rendering is eager, this function doesn't modify this
+   * instance and thus can be called concurrently.
+   */
+  const std::string& query_string() const noexcept
+  {
+    return query_string_;
   }
 
   heap_data_Composite* extra() override
@@ -325,9 +446,9 @@ public:
   const heap_data_Composite* extra() const override
   {
     if (!extra_)
-      extra_.emplace(Extra::extract(fragments_));
+      extra_.emplace(Extra::extract(fragments_, text_));
     else if (is_extra_data_should_be_extracted_from_comments_)
-      extra_->append(heap_data_Composite(Extra::extract(fragments_)));
+      extra_->append(heap_data_Composite(Extra::extract(fragments_, text_)));
     is_extra_data_should_be_extracted_from_comments_ = false;
     DMITIGR_ASSERT(is_invariant_ok());
     return &*extra_;
@@ -359,6 +480,11 @@ private:
 
   constexpr static std::size_t maximum_parameter_count_{65536};
 
+  /**
+   * @brief A fragment of the SQL string.
+   *
+   * The content of the fragment is the range of `text_`.
+   */
   struct Fragment final {
     enum class Type {
       text,
@@ -368,69 +494,241 @@ private:
       positional_parameter
     };
 
-    Fragment(const Type tp, const std::string& s)
-      : type(tp)
-      , str(s)
-    {}
+    /**
+     * @returns The content of this fragment.
+     */
+    std::string_view str(const std::string& text) const noexcept
+    {
+      DMITIGR_ASSERT_NOTHROW(offset + size <= text.size());
+      return std::string_view{text.data() + offset, size};
+    }
+
+    /**
+     * @returns The copy of this fragment with the offset increased by `delta`.
+     */
+    Fragment shifted(const std::size_t delta) const noexcept
+    {
+      return Fragment{type, offset + delta, size};
+    }
 
     Type type;
-    std::string str;
+    std::size_t offset;
+    std::size_t size;
+  };
+  using Fragment_vector = std::vector<Fragment>;
+
+  /**
+   * @brief The unique names of the named parameters in order of their first
+   * appearance, indexed by the name.
+   */
+  class Named_parameters final {
+  public:
+    std::size_t size() const noexcept
+    {
+      return names_.size();
+    }
+
+    bool empty() const noexcept
+    {
+      return names_.empty();
+    }
+
+    const std::string& operator[](const std::size_t index) const noexcept
+    {
+      DMITIGR_ASSERT_NOTHROW(index < size());
+      return names_[index];
+    }
+
+    /**
+     * @returns The index of the `name`, or `size()` if there is no such a name.
+     */
+    std::size_t index(const std::string_view name) const
+    {
+      const auto i = indexes_.find(name);
+      return i != cend(indexes_) ? i->second : size();
+    }
+
+    /**
+     * @brief Appends the `name` unless it's already present.
+     *
+     * @par Exception safety guarantee
+     * Strong.
+     */
+    void push_back(const std::string_view name)
+    {
+      if (indexes_.find(name) == cend(indexes_)) {
+        names_.emplace_back(name);
+        try {
+          indexes_.emplace(names_.back(), names_.size() - 1);
+        } catch (...) {
+          names_.pop_back(); // rollback
+          throw;
+        }
+      }
+    }
+
+    void swap(Named_parameters& other) noexcept
+    {
+      names_.swap(other.names_);
+      indexes_.swap(other.indexes_);
+    }
+
+    /**
+     * @brief The replacement of the names which is prepared by prepare_splice()
+     * and applied by commit().
+     */
+    class Splice final {
+    public:
+      /**
+       * @returns The number of the names after the commit.
+       */
+      std::size_t size() const noexcept
+      {
+        return position_ + tail_.size();
+      }
+
+      /**
+       * @returns The index of the `name` after the commit, or `size()` if
+       * there will be no such a name.
+       */
+      std::size_t index(const std::string_view name) const
+      {
+        if (const auto result = names_->index(name); result < position_)
+          return result;
+        else if (const auto i = tail_indexes_.find(name); i != cend(tail_indexes_))
+          return i->second;
+        else
+          return size();
+      }
+
+    private:
+      friend Named_parameters;
+
+      const Named_parameters* names_{};
+      std::size_t position_{};
+      std::vector<std::string> tail_; // the names starting from `position_`
+      std::map<std::string, std::size_t, std::less<>> tail_indexes_;
+    };
+
+    /**
+     * @returns The splice which replaces `count` names starting from the
+     * `position` with the `names` (except the ones which precede the
+     * `position`), followed by the rest of the names. The names which
+     * precede the `position` are unaffected.
+     *
+     * @par Requires
+     * `(position + count <= size())`.
+     *
+     * @par Exception safety guarantee
+     * Strong. (Only the capacity of this instance can be changed.)
+     */
+    Splice prepare_splice(const std::size_t position, const std::size_t count, const Named_parameters& names)
+    {
+      DMITIGR_ASSERT(position + count <= size());
+      Splice result;
+      result.names_ = this;
+      result.position_ = position;
+      const auto push_back = [this, position, &result](const std::string& name)
+      {
+        if (index(name) >= position && result.tail_indexes_.find(name) == cend(result.tail_indexes_)) {
+          result.tail_indexes_.emplace(name, position + result.tail_.size());
+          result.tail_.push_back(name);
+        }
+      };
+      for (const auto& name : names.names_)
+        push_back(name);
+      for (auto i = position + count; i < size(); ++i)
+        push_back(names_[i]);
+      names_.reserve(result.size());
+      return result;
+    }
+
+    /**
+     * @brief Applies the `splice` prepared by prepare_splice() of this instance.
+     *
+     * @remarks Only the names starting from the position of the `splice` are
+     * updated.
+     */
+    void commit(Splice&& splice) noexcept
+    {
+      DMITIGR_ASSERT_NOTHROW(splice.names_ == this);
+      auto& tail_indexes = splice.tail_indexes_;
+      for (auto i = splice.position_; i < size(); ++i) {
+        if (tail_indexes.find(names_[i]) == cend(tail_indexes))
+          indexes_.erase(names_[i]);
+      }
+      for (auto i = begin(tail_indexes); i != end(tail_indexes);) {
+        if (const auto j = indexes_.find(i->first); j != end(indexes_)) {
+          j->second = i->second;
+          ++i;
+        } else
+          indexes_.insert(tail_indexes.extract(i++)); // the node is reused
+      }
+      names_.erase(begin(names_) + splice.position_, end(names_));
+      for (auto& name : splice.tail_)
+        names_.push_back(std::move(name)); // the capacity is reserved
+    }
+
+  private:
+    std::vector<std::string> names_;
+    std::map<std::string, std::size_t, std::less<>> indexes_;
   };
-  using Fragment_list = std::list<Fragment>;
 
   // ---------------------------------------------------------------------------
   // Initializers
   // ---------------------------------------------------------------------------
 
-  void push_back_fragment__(Fragment::Type type, const std::string& str)
+  /*
+   * The following functions are used by the parser. The `offset` is the offset
+   * of the fragment in the text which is assigned to `text_` by the parser upon
+   * the completion of parsing. The `str` is the content of the fragment.
+   */
+
+  void push_back_fragment__(const Fragment::Type type, const std::size_t offset, const std::string_view str)
   {
-    fragments_.emplace_back(type, str);
+    fragments_.push_back(Fragment{type, offset, str.size()});
+    fragments_size_ += str.size();
     // The invariant should be checked by the caller.
   }
 
-  void push_text(const std::string& str)
+  void push_text(const std::size_t offset, const std::string_view str)
   {
-    push_back_fragment__(Fragment::Type::text, str);
+    push_back_fragment__(Fragment::Type::text, offset, str);
     DMITIGR_ASSERT(is_invariant_ok());
   }
 
-  void push_one_line_comment(const std::string& str)
+  void push_one_line_comment(const std::size_t offset, const std::string_view str)
   {
-    push_back_fragment__(Fragment::Type::one_line_comment, str);
+    push_back_fragment__(Fragment::Type::one_line_comment, offset, str);
     DMITIGR_ASSERT(is_invariant_ok());
   }
 
-  void push_multi_line_comment(const std::string& str)
+  void push_multi_line_comment(const std::size_t offset, const std::string_view str)
   {
-    push_back_fragment__(Fragment::Type::multi_line_comment, str);
+    push_back_fragment__(Fragment::Type::multi_line_comment, offset, str);
     DMITIGR_ASSERT(is_invariant_ok());
   }
 
-  void push_positional_parameter(const std::string& str)
+  void push_positional_parameter(const std::size_t offset, const std::string_view str)
   {
-    push_back_fragment__(Fragment::Type::positional_parameter, str);
-
     using Size = std::vector<bool>::size_type;
-    const decltype (maximum_parameter_count_) position = stoi(str);
-    if (position < 1 || position > maximum_parameter_count_ - 1)
-      throw std::runtime_error("invalid parameter position \"" + str + "\"");
+    std::remove_const_t<decltype (maximum_parameter_count_)> position{};
+    if (const auto [p, ec] = std::from_chars(str.data(), str.data() + str.size(), position);
+      ec != std::errc{} || p != str.data() + str.size() || position < 1 || position > maximum_parameter_count_ - 1)
+      throw std::runtime_error("invalid parameter position \"" + std::string{str} + "\"");
     else if (Size(position) > positional_parameters_.size())
       positional_parameters_.resize(position, false);
 
+    push_back_fragment__(Fragment::Type::positional_parameter, offset, str);
     positional_parameters_[Size(position) - 1] = true; // set parameter presence flag
     DMITIGR_ASSERT(is_invariant_ok());
   }
 
-  void push_named_parameter(const std::string& str)
+  void push_named_parameter(const std::size_t offset, const std::string_view str)
   {
     if (parameter_count() < maximum_parameter_count_) {
-      push_back_fragment__(Fragment::Type::named_parameter, str);
-      if (none_of(cbegin(named_parameters_), cend(named_parameters_),
-          [&str](const auto& i) { return (i->str == str); })) {
-        auto e = cend(fragments_);
-        --e;
-        named_parameters_.push_back(e);
-      }
+      named_parameters_.push_back(str);
+      push_back_fragment__(Fragment::Type::named_parameter, offset, str);
     } else
       throw std::runtime_error{"maximum parameters count (" + std::to_string(maximum_parameter_count_) + ") exceeded"};
 
@@ -442,7 +740,7 @@ private:
   // ---------------------------------------------------------------------------
 
   // Exception safety guarantee: strong.
-  void update_cache(const iSql_string& rhs)
+  void update_cache(const iSql_string& rhs, Named_parameters::Splice&& named_parameters_splice)
   {
     // Preparing for merge positional parameters.
     const auto old_pos_params_size = positional_parameters_.size();
@@ -454,15 +752,15 @@ private:
       const auto new_pos_params_size = positional_parameters_.size();
       DMITIGR_ASSERT(new_pos_params_size >= rhs_pos_params_size);
 
-      // Creating the cache for named parameters.
-      decltype (named_parameters_) new_named_parameters = named_parameters(); // can throw
-
       // Check the new parameter count.
-      const auto new_parameter_count = new_pos_params_size + new_named_parameters.size();
+      const auto new_parameter_count = new_pos_params_size + named_parameters_splice.size();
       if (new_parameter_count > maximum_parameter_count_)
         throw std::runtime_error("parameter count (" + std::to_string(new_parameter_count) + ") "
           "exceeds the maximum (" + std::to_string(maximum_parameter_count_) + ")");
 
+      // Rendering the new query string.
+      auto new_query_string = render_query_string(named_parameters_splice); // can throw
+
       // Merging positional parameters (cannot throw).
       using Counter = std::remove_const_t<decltype (rhs_pos_params_size)>;
       for (Counter i = 0; i < rhs_pos_params_size; ++i) {
@@ -470,7 +768,8 @@ private:
           positional_parameters_[i] = true;
       }
 
-      named_parameters_.swap(new_named_parameters); // commit (cannot throw)
+      named_parameters_.commit(std::move(named_parameters_splice)); // commit (cannot throw)
+      query_string_.swap(new_query_string); // commit (cannot throw)
     } catch (...) {
       positional_parameters_.resize(old_pos_params_size); // rollback
       throw;
@@ -480,41 +779,70 @@ private:
   }
 
   // ---------------------------------------------------------------------------
-  // Generators
+  // Helpers
   // ---------------------------------------------------------------------------
 
-  std::vector<Fragment_list::const_iterator> unique_fragments(const Fragment::Type type) const
+  std::size_t named_parameter_index__(const std::string_view name) const
   {
-    std::vector<Fragment_list::const_iterator> result;
-    result.reserve(8);
-    const auto e = cend(fragments_);
-    for (auto i = cbegin(fragments_); i != e; ++i) {
-      if (i->type == type) {
-        if (none_of(cbegin(result), cend(result), [&i](const auto& result_i) { return (i->str == result_i->str); }))
-          result.push_back(i);
-      }
-    }
-    return result;
+    return positional_parameter_count() + named_parameters_.index(name);
   }
 
-  std::size_t unique_fragment_index(const std::vector<Fragment_list::const_iterator>& unique_fragments,
-    const std::string& str,
-    std::size_t offset = 0) const noexcept
-  {
-    const auto b = cbegin(unique_fragments);
-    const auto e = cend(unique_fragments);
-    const auto i = find_if(b, e, [&str](const auto& pi) { return (pi->str == str); });
-    return offset + (i - b);
-  };
-
-  std::size_t named_parameter_index__(const std::string& name) const
+  /**
+   * @returns The query string of the current fragments where the named
+   * parameters are numbered according to `named_parameters` (either the
+   * Named_parameters or the Named_parameters::Splice).
+   */
+  template<class NamedParameters>
+  std::string render_query_string(const NamedParameters& named_parameters) const
   {
-    return unique_fragment_index(named_parameters_, name, positional_parameter_count());
+    std::string result;
+    result.reserve(text_.size() + 4 * fragments_.size());
+    for (const auto& fragment : fragments_) {
+      const auto str = fragment.str(text_);
+      switch (fragment.type) {
+      case Fragment::Type::text:
+        result += str;
+        break;
+      case Fragment::Type::one_line_comment:
+      case Fragment::Type::multi_line_comment:
+        break;
+      case Fragment::Type::named_parameter: {
+        const auto idx = positional_parameter_count() + named_parameters.index(str);
+        DMITIGR_ASSERT(idx < positional_parameter_count() + named_parameters.size());
+        result += '$';
+        result += std::to_string(idx + 1);
+        break;
+      }
+      case Fragment::Type::positional_parameter:
+        result += '$';
+        result += str;
+        break;
+      }
+    }
+    return result;
   }
 
-  std::vector<Fragment_list::const_iterator> named_parameters() const
+  /**
+   * @brief Rebases the fragments onto the new text which consists of their
+   * contents only, in order to release the unreferenced bytes of `text_`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  void compact_text()
   {
-    return unique_fragments(Fragment::Type::named_parameter);
+    std::string new_text;
+    new_text.reserve(fragments_size_);
+    for (const auto& fragment : fragments_)
+      new_text.append(fragment.str(text_));
+
+    // Commit (cannot throw).
+    std::size_t offset{};
+    for (auto& fragment : fragments_) {
+      fragment.offset = offset;
+      offset += fragment.size;
+    }
+    text_.swap(new_text);
   }
 
   // ---------------------------------------------------------------------------
@@ -523,10 +851,10 @@ private:
 
   static bool is_space(const char c)
   {
-    return std::isspace(c, std::locale{});
+    return is_space_char(c);
   }
 
-  static bool is_blank_string(const std::string& str)
+  static bool is_blank_string(const std::string_view str)
   {
     return std::all_of(cbegin(str), cend(str), is_space);
   };
@@ -565,18 +893,20 @@ private:
     /** Denotes the fragment type. */
     using Fragment = iSql_string::Fragment;
 
-    /** Denotes the fragment list type. */
-    using Fragment_list = iSql_string::Fragment_list;
+    /** Denotes the fragment vector type. */
+    using Fragment_vector = iSql_string::Fragment_vector;
 
     /**
      * @returns The vector of associated extra data.
+     *
+     * @param text - the text which contains the contents of the `fragments`.
      */
-    static std::vector<std::pair<Key, Value>> extract(const Fragment_list& fragments)
+    static std::vector<std::pair<Key, Value>> extract(const Fragment_vector& fragments, const std::string& text)
     {
       std::vector<std::pair<Key, Value>> result;
-      const auto iters = first_related_comments(fragments);
+      const auto iters = first_related_comments(fragments, text);
       if (iters.first != cend(fragments)) {
-        const auto comments = joined_comments(iters.first, iters.second);
+        const auto comments = joined_comments(iters.first, iters.second, text);
         for (const auto& comment : comments) {
           auto associations = extract(comment.first, comment.second);
           result.reserve(result.capacity() + associations.size());
@@ -618,7 +948,7 @@ private:
 
       const auto is_valid_tag_char = [](const char c)
       {
-        return std::isalnum(c, std::locale{}) || c == '_' || c == '-';
+        return is_alnum_char(c) || c == '_' || c == '-';
       };
 
       for (const auto current_char : input) {
@@ -701,7 +1031,7 @@ private:
             count = 0;
           else if (current_char == '*')
             state = after_asterisk;
-          else if (std::isspace(current_char, std::locale{}))
+          else if (is_space_char(current_char))
             ++count;
           else
             state = after_non_asterisk;
@@ -819,14 +1149,14 @@ private:
      *
      * @returns The pair of iterators that specifies the range of relevant comments.
      */
-    std::pair<Fragment_list::const_iterator, Fragment_list::const_iterator>
-    static first_related_comments(const Fragment_list& fragments)
+    std::pair<Fragment_vector::const_iterator, Fragment_vector::const_iterator>
+    static first_related_comments(const Fragment_vector& fragments, const std::string& text)
     {
       const auto b = cbegin(fragments);
       const auto e = cend(fragments);
       auto result = std::make_pair(e, e);
 
-      const auto is_nearby_string = [&](const std::string& str)
+      const auto is_nearby_string = [&](const std::string_view str)
       {
         std::string::size_type count{};
         for (const auto c : str) {
@@ -846,7 +1176,7 @@ private:
        */
       auto i = std::find_if(b, e, [&](const Fragment& f)
       {
-        return (f.type == Fragment::Type::text && is_nearby_string(f.str) && !is_blank_string(f.str)) ||
+        return (f.type == Fragment::Type::text && is_nearby_string(f.str(text)) && !is_blank_string(f.str(text))) ||
           f.type == Fragment::Type::named_parameter ||
           f.type == Fragment::Type::positional_parameter;
       });
@@ -854,9 +1184,9 @@ private:
         result.second = i;
         do {
           --i;
-          DMITIGR_ASSERT(is_comment(*i) || (is_text(*i) && is_blank_string(i->str)));
+          DMITIGR_ASSERT(is_comment(*i) || (is_text(*i) && is_blank_string(i->str(text))));
           if (i->type == Fragment::Type::text) {
-            if (!is_nearby_string(i->str))
+            if (!is_nearby_string(i->str(text)))
               break;
           }
           result.first = i;
@@ -874,14 +1204,15 @@ private:
      *   - the iterator that points to the fragment that follows the last comment
      *     appended to the result.
      */
-    std::pair<std::pair<std::string, Extra::Comment_type>, Fragment_list::const_iterator>
-    static joined_comments_of_same_type(Fragment_list::const_iterator i, const Fragment_list::const_iterator e)
+    std::pair<std::pair<std::string, Extra::Comment_type>, Fragment_vector::const_iterator>
+    static joined_comments_of_same_type(Fragment_vector::const_iterator i, const Fragment_vector::const_iterator e,
+      const std::string& text)
     {
       DMITIGR_ASSERT(is_comment(*i));
       std::string result;
       const auto fragment_type = i->type;
-      for (; i->type == fragment_type && i != e; ++i) {
-        result.append(i->str);
+      for (; i != e && i->type == fragment_type; ++i) {
+        result.append(i->str(text));
         if (fragment_type == Fragment::Type::one_line_comment)
           result.append("\n");
       }
@@ -904,12 +1235,13 @@ private:
      *   - the type of the joined comments as second element.
      */
     std::vector<std::pair<std::string, Extra::Comment_type>>
-    static joined_comments(Fragment_list::const_iterator i, const Fragment_list::const_iterator e)
+    static joined_comments(Fragment_vector::const_iterator i, const Fragment_vector::const_iterator e,
+      const std::string& text)
     {
       std::vector<std::pair<std::string, Extra::Comment_type>> result;
       while (i != e) {
         if (is_comment(*i)) {
-          auto comments = joined_comments_of_same_type(i, e);
+          auto comments = joined_comments_of_same_type(i, e, text);
           result.push_back(std::move(comments.first));
           i = comments.second;
         } else
@@ -919,9 +1251,12 @@ private:
     }
   };
 
-  Fragment_list fragments_;
+  std::string text_; // the contents of the fragments
+  Fragment_vector fragments_;
+  std::size_t fragments_size_{}; // the total size of the contents of the fragments
   std::vector<bool> positional_parameters_; // cache
-  std::vector<Fragment_list::const_iterator> named_parameters_; // cache
+  Named_parameters named_parameters_; // cache
+  std::string query_string_; // cache
   mutable bool is_extra_data_should_be_extracted_from_comments_{true};
   mutable std::optional<heap_data_Composite> extra_; // cache
 };
@@ -997,21 +1332,12 @@ private:
 
 namespace dmitigr::pgfe::detail {
 
-namespace {
-
-/**
- * @returns `true` if `c` is a valid character of unquoted SQL identifier.
- */
-inline bool is_ident_char(const char c) noexcept
-{
-  return (std::isalnum(c, std::locale{}) || c == '_' || c == '$');
-}
-
-} // namespace
-
 /**
  * @returns Preparsed SQL string in pair with the pointer to a character
  * that follows the SQL string.
+ *
+ * @remarks The input is scanned once. The fragments are stored as the ranges
+ * of the single copy of the parsed input.
  */
 std::pair<iSql_string, const char*> parse_sql_input(const char* text)
 {
@@ -1043,13 +1369,18 @@ std::pair<iSql_string, const char*> parse_sql_input(const char* text)
   } state = top;
 
   iSql_string result;
+  const char* const input = text;
+  const auto offset = [input](const char* const pos) { return static_cast<std::size_t>(pos - input); };
+  const auto range = [](const char* const b, const char* const e) { return std::string_view(b, e - b); };
+
   int depth{};
   char current_char{*text};
   char previous_char{};
   char quote_char{};
-  std::string fragment;
-  std::string dollar_quote_leading_tag_name;
-  std::string dollar_quote_trailing_tag_name;
+  const char* fragment{text}; // the beginning of the current fragment
+  const char* leading_tag_begin{};
+  std::string_view leading_tag_name;
+  const char* trailing_tag_begin{};
   for (; current_char; previous_char = current_char, current_char = *++text) {
     switch (state) {
     case top:
@@ -1057,34 +1388,27 @@ std::pair<iSql_string, const char*> parse_sql_input(const char* text)
       case '\'':
         state = quote;
         quote_char = current_char;
-        fragment += current_char;
         continue;
 
       case '"':
         state = quote;
         quote_char = current_char;
-        fragment += current_char;
         continue;
 
       case '[':
         state = bracket;
         depth = 1;
-        fragment += current_char;
         continue;
 
       case '$':
         if (!is_ident_char(previous_char))
           state = dollar;
-        else
-          fragment += current_char;
 
         continue;
 
       case ':':
         if (previous_char != ':')
           state = colon;
-        else
-          fragment += current_char;
 
         continue;
 
@@ -1100,7 +1424,6 @@ std::pair<iSql_string, const char*> parse_sql_input(const char* text)
         goto finish;
 
       default:
-        fragment += current_char;
         continue;
       } // switch (current_char)
 
@@ -1115,151 +1438,125 @@ std::pair<iSql_string, const char*> parse_sql_input(const char* text)
         state = top;
       }
 
-      fragment += current_char;
       continue;
 
     case dollar:
       DMITIGR_ASSERT(previous_char == '$');
-      if (std::isdigit(current_char, std::locale{})) {
+      if (is_digit_char(current_char)) {
         state = positional_parameter;
-        result.push_text(fragment);
-        fragment.clear();
-        // The first digit of positional parameter (current_char) will be stored below.
+        result.push_text(offset(fragment), range(fragment, text - 1));
+        fragment = text; // the first digit of positional parameter
       } else if (is_ident_char(current_char)) {
         if (current_char == '$') {
           state = dollar_quote;
+          leading_tag_name = {};
         } else {
           state = dollar_quote_leading_tag;
-          dollar_quote_leading_tag_name += current_char;
+          leading_tag_begin = text;
         }
-        fragment += previous_char;
-      } else {
+      } else
         state = top;
-        fragment += previous_char;
-      }
 
-      fragment += current_char;
       continue;
 
     case positional_parameter:
-      DMITIGR_ASSERT(std::isdigit(previous_char, std::locale{}));
-      if (!std::isdigit(current_char, std::locale{})) {
+      DMITIGR_ASSERT(is_digit_char(previous_char));
+      if (!is_digit_char(current_char)) {
         state = top;
-        result.push_positional_parameter(fragment);
-        fragment.clear();
+        result.push_positional_parameter(offset(fragment), range(fragment, text));
+        fragment = text;
       }
 
-      if (current_char != ';') {
-        fragment += current_char;
+      if (current_char != ';')
         continue;
-      } else
+      else
         goto finish;
 
     case dollar_quote_leading_tag:
       DMITIGR_ASSERT(previous_char != '$' && is_ident_char(previous_char));
       if (current_char == '$') {
         state = dollar_quote;
-      } else if (is_ident_char(current_char)) {
-        dollar_quote_leading_tag_name += current_char;
-        fragment += current_char;
-      } else
+        leading_tag_name = range(leading_tag_begin, text);
+      } else if (!is_ident_char(current_char))
         throw std::runtime_error("invalid dollar quote tag");
 
       continue;
 
     case dollar_quote:
-      if (current_char == '$')
+      if (current_char == '$') {
         state = dollar_quote_dollar;
+        trailing_tag_begin = text + 1;
+      }
 
-      fragment += current_char;
       continue;
 
     case dollar_quote_dollar:
       if (current_char == '$') {
-        if (dollar_quote_leading_tag_name == dollar_quote_trailing_tag_name) {
+        if (leading_tag_name == range(trailing_tag_begin, text))
           state = top;
-          dollar_quote_leading_tag_name.clear();
-        } else
+        else
           state = dollar_quote;
+      }
 
-        dollar_quote_trailing_tag_name.clear();
-      } else
-        dollar_quote_trailing_tag_name += current_char;
-
-      fragment += current_char;
       continue;
 
     case colon:
       DMITIGR_ASSERT(previous_char == ':');
       if (is_ident_char(current_char)) {
         state = named_parameter;
-        result.push_text(fragment);
-        fragment.clear();
-        // The first character of the named parameter (current_char) will be stored below.
-      } else {
+        result.push_text(offset(fragment), range(fragment, text - 1));
+        fragment = text; // the first character of the named parameter
+      } else
         state = top;
-        fragment += previous_char;
-      }
 
-      if (current_char != ';') {
-        fragment += current_char;
+      if (current_char != ';')
         continue;
-      } else
+      else
         goto finish;
 
     case named_parameter:
       DMITIGR_ASSERT(is_ident_char(previous_char));
       if (!is_ident_char(current_char)) {
         state = top;
-        result.push_named_parameter(fragment);
-        fragment.clear();
+        result.push_named_parameter(offset(fragment), range(fragment, text));
+        fragment = text;
       }
 
-      if (current_char != ';') {
-        fragment += current_char;
+      if (current_char != ';')
         continue;
-      } else
+      else
         goto finish;
 
     case quote:
       if (current_char == quote_char)
         state = quote_quote;
-      else
-        fragment += current_char;
 
       continue;
 
     case quote_quote:
       DMITIGR_ASSERT(previous_char == quote_char);
-      if (current_char == quote_char) {
+      if (current_char == quote_char)
         state = quote;
-        // Skip previous quote.
-      } else {
+      else
         state = top;
-        fragment += previous_char; // store previous quote
-      }
 
-      if (current_char != ';') {
-        fragment += current_char;
+      if (current_char != ';')
         continue;
-      } else
+      else
         goto finish;
 
     case dash:
       DMITIGR_ASSERT(previous_char == '-');
       if (current_char == '-') {
         state = one_line_comment;
-        result.push_text(fragment);
-        fragment.clear();
-        // The comment marker ("--") will not be included in the next fragment.
+        result.push_text(offset(fragment), range(fragment, text - 1));
+        fragment = text + 1; // the comment marker ("--") is not included
       } else {
         state = top;
-        fragment += previous_char;
 
-        if (current_char != ';') {
-          fragment += current_char;
+        if (current_char != ';')
           continue;
-        } else
+        else
           goto finish;
       }
 
@@ -1268,12 +1565,10 @@ std::pair<iSql_string, const char*> parse_sql_input(const char* text)
     case one_line_comment:
       if (current_char == '\n') {
         state = top;
-        if (!fragment.empty() && fragment.back() == '\r')
-          fragment.pop_back();
-        result.push_one_line_comment(fragment);
-        fragment.clear();
-      } else
-        fragment += current_char;
+        const char* const end = (text > fragment && previous_char == '\r') ? text - 1 : text;
+        result.push_one_line_comment(offset(fragment), range(fragment, end));
+        fragment = text + 1; // the trailing newline is not included
+      }
 
       continue;
 
@@ -1281,30 +1576,21 @@ std::pair<iSql_string, const char*> parse_sql_input(const char* text)
       DMITIGR_ASSERT(previous_char == '/');
       if (current_char == '*') {
         state = multi_line_comment;
-        if (depth > 0) {
-          fragment += previous_char;
-          fragment += current_char;
-        } else {
-          result.push_text(fragment);
-          fragment.clear();
-          // The comment marker ("/*") will not be included in the next fragment.
+        if (depth == 0) {
+          result.push_text(offset(fragment), range(fragment, text - 1));
+          fragment = text + 1; // the comment marker ("/*") is not included
         }
         ++depth;
-      } else {
+      } else
         state = (depth == 0) ? top : multi_line_comment;
-        fragment += previous_char;
-        fragment += current_char;
-      }
 
       continue;
 
     case multi_line_comment:
-      if (current_char == '/') {
+      if (current_char == '/')
         state = slash;
-      } else if (current_char == '*') {
+      else if (current_char == '*')
         state = multi_line_comment_star;
-      } else
-        fragment += current_char;
 
       continue;
 
@@ -1314,18 +1600,12 @@ std::pair<iSql_string, const char*> parse_sql_input(const char* text)
         --depth;
         if (depth == 0) {
           state = top;
-          result.push_multi_line_comment(fragment); // without trailing "*/"
-          fragment.clear();
-        } else {
+          result.push_multi_line_comment(offset(fragment), range(fragment, text - 1)); // without trailing "*/"
+          fragment = text + 1;
+        } else
           state = multi_line_comment;
-          fragment += previous_char; // '*'
-          fragment += current_char;  // '/'
-        }
-      } else {
+      } else
         state = multi_line_comment;
-        fragment += previous_char;
-        fragment += current_char;
-      }
 
       continue;
     } // switch (state)
@@ -1334,29 +1614,33 @@ std::pair<iSql_string, const char*> parse_sql_input(const char* text)
  finish:
   switch (state) {
   case top:
-    if (current_char == ';')
-      ++text;
-    if (!fragment.empty())
-      result.push_text(fragment);
+    if (fragment < text)
+      result.push_text(offset(fragment), range(fragment, text));
     break;
   case quote_quote:
-    fragment += previous_char;
-    result.push_text(fragment);
+    result.push_text(offset(fragment), range(fragment, text));
     break;
   case one_line_comment:
-    result.push_one_line_comment(fragment);
+    result.push_one_line_comment(offset(fragment), range(fragment, text));
     break;
   case positional_parameter:
-    result.push_positional_parameter(fragment);
+    result.push_positional_parameter(offset(fragment), range(fragment, text));
     break;
   case named_parameter:
-    result.push_named_parameter(fragment);
+    result.push_named_parameter(offset(fragment), range(fragment, text));
     break;
   default:
     throw std::runtime_error{"invalid SQL input"};
   }
 
-  return std::make_pair(result, text);
+  // The contents of all the fragments are the ranges of the parsed input.
+  result.text_.assign(input, text);
+  result.query_string_ = result.render_query_string(result.named_parameters_);
+
+  if (current_char == ';')
+    ++text;
+
+  return std::make_pair(std::move(result), text);
 }
 
 } // namespace dmitigr::pgfe::detail
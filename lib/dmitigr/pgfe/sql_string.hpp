@@ -148,6 +148,10 @@ public:
 
   /**
    * @returns The query string that's actually passed to a PostgreSQL server.
+   *
+   * @remarks The query string is rendered upon the parsing and upon each
+   * modification of this instance, so this function doesn't modify it and can
+   * be called concurrently.
    */
   virtual std::string to_query_string() const = 0;
 
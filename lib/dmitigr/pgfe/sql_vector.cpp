@@ -8,6 +8,9 @@
 
 #include "dmitigr/util/debug.hpp"
 
+#include <algorithm>
+#include <unordered_map>
+
 namespace dmitigr::pgfe::detail {
 
 /**
@@ -29,7 +32,7 @@ public:
   {
     const char* text{input.c_str()};
     while (*text != '\0') {
-      const auto parsed = parse_sql_input(text);
+      auto parsed = parse_sql_input(text);
       auto s = std::make_unique<iSql_string>(std::move(parsed.first));
       storage_.push_back(std::move(s));
       text = parsed.second;
@@ -51,6 +54,8 @@ public:
    */
   iSql_vector(const iSql_vector& rhs)
     : storage_(rhs.storage_.size())
+    , indexed_extra_name_{rhs.indexed_extra_name_}
+    , extra_index_{rhs.extra_index_}
   {
     std::transform(cbegin(rhs.storage_), cend(rhs.storage_), begin(storage_),
       [](const auto& sqlstr) { return sqlstr->to_sql_string(); });
@@ -83,6 +88,8 @@ public:
   void swap(iSql_vector& rhs) noexcept
   {
     storage_.swap(rhs.storage_);
+    indexed_extra_name_.swap(rhs.indexed_extra_name_);
+    extra_index_.swap(rhs.extra_index_);
   }
 
   std::unique_ptr<Sql_vector> to_sql_vector() const override
@@ -110,6 +117,15 @@ public:
     const std::size_t offset, const std::size_t extra_offset) const override
   {
     if (offset < sql_string_count()) {
+      if (extra_offset == 0 && indexed_extra_name_ && *indexed_extra_name_ == extra_name) {
+        if (const auto i = extra_index_.find(extra_value); i != cend(extra_index_)) {
+          const auto& positions = i->second;
+          const auto p = std::lower_bound(cbegin(positions), cend(positions), offset);
+          return p != cend(positions) ? std::make_optional(*p) : std::nullopt;
+        } else
+          return std::nullopt;
+      }
+
       const auto b = cbegin(storage_);
       const auto e = cend(storage_);
       const auto i = std::find_if(b + offset, e,
@@ -163,30 +179,73 @@ public:
     return sql_string(index);
   }
 
+  const std::optional<std::string>& indexed_extra_name() const noexcept override
+  {
+    return indexed_extra_name_;
+  }
+
   void set_sql_string(const std::size_t index, std::unique_ptr<Sql_string>&& sql_string) override
   {
     DMITIGR_REQUIRE(index < sql_string_count(), std::out_of_range);
     DMITIGR_REQUIRE(sql_string, std::invalid_argument);
-    storage_[index] = std::move(sql_string);
+    storage_[index].swap(sql_string);
+    try {
+      reindex(); // can throw
+    } catch (...) {
+      storage_[index].swap(sql_string); // rollback
+      throw;
+    }
   }
 
   void append_sql_string(std::unique_ptr<Sql_string>&& sql_string) override
   {
     DMITIGR_REQUIRE(sql_string, std::invalid_argument);
     storage_.push_back(std::move(sql_string));
+    if (indexed_extra_name_) {
+      try {
+        index_sql_string(extra_index_, storage_.size() - 1); // can throw
+      } catch (...) {
+        sql_string = std::move(storage_.back()); // rollback
+        storage_.pop_back();
+        throw;
+      }
+    }
   }
 
   void insert_sql_string(const std::size_t index, std::unique_ptr<Sql_string>&& sql_string) override
   {
     DMITIGR_REQUIRE(index < sql_string_count(), std::out_of_range);
     DMITIGR_REQUIRE(sql_string, std::invalid_argument);
-    storage_.insert(begin(storage_) + index, std::move(sql_string));
+    const auto i = storage_.insert(begin(storage_) + index, std::move(sql_string));
+    try {
+      reindex(); // can throw
+    } catch (...) {
+      sql_string = std::move(*i); // rollback
+      storage_.erase(i);
+      throw;
+    }
   }
 
   void remove_sql_string(const std::size_t index) override
   {
     DMITIGR_REQUIRE(index < sql_string_count(), std::out_of_range);
-    storage_.erase(begin(storage_) + index);
+    auto removed = std::move(storage_[index]);
+    const auto i = storage_.erase(begin(storage_) + index);
+    try {
+      reindex(); // can throw
+    } catch (...) {
+      storage_.insert(i, std::move(removed)); // rollback (cannot throw since the capacity is retained)
+      throw;
+    }
+  }
+
+  void set_indexed_extra_name(std::optional<std::string> extra_name) override
+  {
+    Extra_index new_index;
+    if (extra_name)
+      new_index = make_extra_index(*extra_name); // can throw
+    indexed_extra_name_.swap(extra_name);
+    extra_index_.swap(new_index);
   }
 
   std::string to_string() const override
@@ -210,6 +269,7 @@ public:
   {
     std::vector<std::unique_ptr<Sql_string>> result;
     storage_.swap(result);
+    extra_index_.clear();
     return std::move(result);
   }
 
@@ -220,7 +280,62 @@ protected:
   }
 
 private:
+  using Extra_index = std::unordered_map<std::string, std::vector<std::size_t>>;
+
   mutable std::vector<std::unique_ptr<Sql_string>> storage_;
+  std::optional<std::string> indexed_extra_name_;
+  Extra_index extra_index_; // cache
+
+  /**
+   * @returns The index by the extra data field `extra_name` which maps the
+   * values of this field to the sorted positions of SQL strings.
+   */
+  Extra_index make_extra_index(const std::string& extra_name) const
+  {
+    Extra_index result;
+    result.reserve(storage_.size());
+    for (std::size_t i = 0; i < storage_.size(); ++i)
+      index_sql_string(result, i, extra_name);
+    return result;
+  }
+
+  /**
+   * @brief Rebuilds the index if `indexed_extra_name_`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  void reindex()
+  {
+    if (indexed_extra_name_)
+      extra_index_ = make_extra_index(*indexed_extra_name_); // can throw
+  }
+
+  /**
+   * @brief Adds the SQL string at `position` to the `index`.
+   *
+   * @par Requires
+   * `(position` is greater than the positions of already indexed SQL strings`)`.
+   */
+  void index_sql_string(Extra_index& index, const std::size_t position, const std::string& extra_name) const
+  {
+    DMITIGR_ASSERT(position < storage_.size());
+    if (const auto* const extra = storage_[position]->extra()) {
+      if (const auto i = extra->field_index(extra_name); i) {
+        if (const auto* const data = extra->data(*i))
+          index[data->bytes()].push_back(position);
+      }
+    }
+  }
+
+  /**
+   * @overload
+   */
+  void index_sql_string(Extra_index& index, const std::size_t position) const
+  {
+    DMITIGR_ASSERT(indexed_extra_name_);
+    index_sql_string(index, position, *indexed_extra_name_);
+  }
 };
 
 } // namespace dmitigr::pgfe::detail
@@ -156,6 +156,14 @@ public:
   virtual const Sql_string* sql_string(const std::string& extra_name, const std::string& extra_value,
     std::size_t offset = 0, std::size_t extra_offset = 0) const = 0;
 
+  /**
+   * @returns The name of the extra data field by which the SQL strings
+   * of this vector are indexed, or `std::nullopt` if there is no index.
+   *
+   * @see set_indexed_extra_name().
+   */
+  virtual const std::optional<std::string>& indexed_extra_name() const noexcept = 0;
+
   /// @}
 
   // ===========================================================================
@@ -235,6 +243,28 @@ public:
    */
   virtual void remove_sql_string(std::size_t index) = 0;
 
+  /**
+   * @brief Sets the name of the extra data field by which the SQL strings of
+   * this vector are indexed.
+   *
+   * The lookup of the SQL string by the value of the indexed extra data field
+   * (with `extra_offset == 0`), such as `sql_string("id", "query_1")`, takes
+   * constant time on average instead of linear. The index is built by this
+   * function and kept consistent upon the modifications of this vector, so the
+   * lookups by the indexed field don't modify this vector.
+   *
+   * @param extra_name - the name of the extra data field to index by, or
+   * `std::nullopt` to drop the index.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The modifications of the extra data of the SQL strings made via
+   * the pointers returned by sql_string() are not tracked by the index. This
+   * function should be called again to rebuild the index after them.
+   */
+  virtual void set_indexed_extra_name(std::optional<std::string> extra_name) = 0;
+
   /// @}
 
   // ===========================================================================
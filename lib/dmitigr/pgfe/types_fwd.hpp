@@ -23,6 +23,7 @@ namespace dmitigr::pgfe {
 
 enum class Communication_mode;
 enum class Communication_status;
+enum class Data_direction;
 enum class Data_format;
 enum class External_library;
 enum class Password_encryption;
@@ -44,17 +45,26 @@ class Composite;
 class Compositional;
 class Connection;
 class Connection_options;
+class Connection_pool;
+struct Connection_statistics;
+class Copier;
+class Cursor;
 class Data;
 class Error;
 class Message;
 class Notice;
 class Notification;
+class Notification_dispatcher;
 class Parameterizable;
 class Prepared_statement;
 class Problem;
+class Reactor;
+class Record;
+struct Request_info;
 class Response;
 class Row;
 class Row_info;
+class Row_set;
 class Server_message;
 class Signal;
 class Sql_vector;
@@ -64,6 +74,8 @@ class Client_exception;
 class Server_exception;
 
 template<typename> struct Conversions;
+template<typename> struct Is_binary_data_convertible;
+template<typename...> class Row_mapper;
 
 /**
  * @brief The implementation details.
@@ -74,22 +86,33 @@ class iCompletion;
 class iComposite;
 class iConnection;
 class iConnection_options;
+class iConnection_pool;
+class iCopier;
+class iCursor;
 class iData;
 class iError;
 class iNotice;
 class iNotification;
+class iNotification_dispatcher;
 class iPrepared_statement;
+class iReactor;
+class iRecord;
 class iRow;
 class iRow_info;
+class iRow_set;
 class iSql_vector;
 class iSql_string;
 
+class Field_names;
+
 class pq_Connection;
 class pq_Connection_options;
+class pq_Copier;
 class pq_Notification;
 class pq_Prepared_statement;
 class pq_Row;
 class pq_Row_info;
+class pq_Row_set;
 
 class iClient_exception;
 class iServer_exception;
@@ -0,0 +1,12 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or ttpl.hpp
+
+#ifdef DMITIGR_TTPL_NOMINMAX
+#undef DMITIGR_TTPL_NOMINMAX
+#undef NOMINMAX
+#endif
+
+#ifdef DMITIGR_TTPL_INLINE
+#undef DMITIGR_TTPL_INLINE
+#endif
@@ -0,0 +1,20 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or ttpl.hpp
+
+#ifndef DMITIGR_TTPL_INLINE
+  #if defined(DMITIGR_TTPL_HEADER_ONLY) && !defined(DMITIGR_TTPL_BUILDING)
+    #define DMITIGR_TTPL_INLINE inline
+  #else
+    #define DMITIGR_TTPL_INLINE
+  #endif
+#endif  // DMITIGR_TTPL_INLINE
+
+#ifndef DMITIGR_TTPL_NOMINMAX
+  #ifdef _WIN32
+    #ifndef NOMINMAX
+      #define NOMINMAX
+      #define DMITIGR_TTPL_NOMINMAX
+    #endif
+  #endif
+#endif  // DMITIGR_TTPL_NOMINMAX
@@ -0,0 +1,22 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or url.hpp
+
+#ifndef DMITIGR_URL_DLL_HPP
+#define DMITIGR_URL_DLL_HPP
+
+#ifdef _WIN32
+  #ifdef DMITIGR_CEFEIKA_DLL_BUILDING
+    #define DMITIGR_URL_API __declspec(dllexport)
+  #else
+    #if DMITIGR_URL_DLL
+      #define DMITIGR_URL_API __declspec(dllimport)
+    #else /* static or header-only library on Windows */
+      #define DMITIGR_URL_API
+    #endif
+  #endif
+#else /* Unix */
+  #define DMITIGR_URL_API
+#endif
+
+#endif // DMITIGR_URL_DLL_HPP
@@ -0,0 +1,12 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or url.hpp
+
+#ifdef DMITIGR_URL_NOMINMAX
+#undef DMITIGR_URL_NOMINMAX
+#undef NOMINMAX
+#endif
+
+#ifdef DMITIGR_URL_INLINE
+#undef DMITIGR_URL_INLINE
+#endif
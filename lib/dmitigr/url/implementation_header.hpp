@@ -0,0 +1,20 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or url.hpp
+
+#ifndef DMITIGR_URL_INLINE
+  #if defined(DMITIGR_URL_HEADER_ONLY) && !defined(DMITIGR_URL_BUILDING)
+    #define DMITIGR_URL_INLINE inline
+  #else
+    #define DMITIGR_URL_INLINE
+  #endif
+#endif  // DMITIGR_URL_INLINE
+
+#ifndef DMITIGR_URL_NOMINMAX
+  #ifdef _WIN32
+    #ifndef NOMINMAX
+      #define NOMINMAX
+      #define DMITIGR_URL_NOMINMAX
+    #endif
+  #endif
+#endif  // DMITIGR_URL_NOMINMAX
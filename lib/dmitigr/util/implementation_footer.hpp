@@ -0,0 +1,12 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or util.hpp
+
+#ifdef DMITIGR_UTIL_NOMINMAX
+#undef DMITIGR_UTIL_NOMINMAX
+#undef NOMINMAX
+#endif
+
+#ifdef DMITIGR_UTIL_INLINE
+#undef DMITIGR_UTIL_INLINE
+#endif
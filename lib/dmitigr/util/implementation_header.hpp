@@ -0,0 +1,20 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or util.hpp
+
+#ifndef DMITIGR_UTIL_INLINE
+  #if defined(DMITIGR_UTIL_HEADER_ONLY) && !defined(DMITIGR_UTIL_BUILDING)
+    #define DMITIGR_UTIL_INLINE inline
+  #else
+    #define DMITIGR_UTIL_INLINE
+  #endif
+#endif  // DMITIGR_UTIL_INLINE
+
+#ifndef DMITIGR_UTIL_NOMINMAX
+  #ifdef _WIN32
+    #ifndef NOMINMAX
+      #define NOMINMAX
+      #define DMITIGR_UTIL_NOMINMAX
+    #endif
+  #endif
+#endif  // DMITIGR_UTIL_NOMINMAX
@@ -5,7 +5,9 @@
 #ifndef DMITIGR_UTIL_MEMORY_HPP
 #define DMITIGR_UTIL_MEMORY_HPP
 
+#include <cstddef>
 #include <memory>
+#include <new>
 
 namespace dmitigr::memory {
 
@@ -55,6 +57,87 @@ private:
   bool condition_{true};
 };
 
+/**
+ * @brief A thread-local pool of memory blocks of the same size.
+ *
+ * The deallocated blocks are retained (up to `Capacity` blocks per thread) and
+ * reused by the subsequent allocations of the same thread instead of returning
+ * them to the free store. This is suitable for the objects which are created
+ * and destroyed at high rate, such as the rows of query results.
+ *
+ * @tparam BlockSize - the size of the blocks;
+ * @tparam Capacity - the maximum number of the retained blocks per thread.
+ *
+ * @remarks The block allocated in one thread can be deallocated in another.
+ * The blocks retained by the thread are released at the thread exit.
+ */
+template<std::size_t BlockSize, std::size_t Capacity = 32>
+class Block_pool final {
+public:
+  static_assert(BlockSize > 0 && Capacity > 0);
+
+  /**
+   * @returns The pointer to the block of memory of size `BlockSize`
+   * suitably aligned for any object of such size.
+   *
+   * @throws `std::bad_alloc` on allocation failure.
+   */
+  static void* allocate()
+  {
+    auto& fl = free_list_;
+    if (fl.size > 0)
+      return fl.blocks[--fl.size];
+    else
+      return ::operator new(BlockSize);
+  }
+
+  /**
+   * @brief Returns the `block` obtained by allocate() back to the pool.
+   */
+  static void deallocate(void* const block) noexcept
+  {
+    if (!block)
+      return;
+
+    auto& fl = free_list_;
+    if (!fl.is_finalized && fl.size < Capacity) {
+      if (fl.size == 0)
+        register_finalizer();
+      fl.blocks[fl.size++] = block;
+    } else
+      ::operator delete(block);
+  }
+
+private:
+  /*
+   * Note: the free list is trivially destructible in order to remain usable
+   * during the destruction of the other objects at the thread exit.
+   */
+  struct Free_list final {
+    void* blocks[Capacity];
+    std::size_t size;
+    bool is_finalized;
+  };
+
+  struct Finalizer final {
+    ~Finalizer()
+    {
+      auto& fl = free_list_;
+      while (fl.size > 0)
+        ::operator delete(fl.blocks[--fl.size]);
+      fl.is_finalized = true;
+    }
+  };
+
+  static void register_finalizer() noexcept
+  {
+    static thread_local const Finalizer finalizer;
+    (void)finalizer;
+  }
+
+  inline static thread_local Free_list free_list_{};
+};
+
 } // namespace dmitigr::memory
 
 #endif  // DMITIGR_UTIL_MEMORY_HPP
@@ -29,7 +29,7 @@
 #include <cerrno>
 
 #include <arpa/inet.h>
-#include <sys/select.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/un.h>
@@ -1138,6 +1138,13 @@ DMITIGR_UTIL_INLINE Socket_readiness poll(const Socket_native socket,
   const auto sock = socket;
 #endif
 
+  using Ut = std::underlying_type_t<Socket_readiness>;
+
+#ifdef _WIN32
+  /*
+   * On Windows fd_set is an array of sockets rather than a bitmask indexed by
+   * the socket value, so select() is not limited by the values of sockets.
+   */
   using std::chrono::seconds;
   using std::chrono::milliseconds;
   using std::chrono::microseconds;
@@ -1166,8 +1173,6 @@ DMITIGR_UTIL_INLINE Socket_readiness poll(const Socket_native socket,
   fd_set except_mask;
   FD_ZERO(&except_mask);
 
-  using Ut = std::underlying_type_t<Socket_readiness>;
-
   if (static_cast<Ut>(mask & Socket_readiness::read_ready))
     FD_SET(sock, &read_mask);
 
@@ -1177,14 +1182,46 @@ DMITIGR_UTIL_INLINE Socket_readiness poll(const Socket_native socket,
   if (static_cast<Ut>(mask & Socket_readiness::exceptions))
     FD_SET(sock, &except_mask);
 
-  const int r = ::select(static_cast<int>(sock + 1) /* ignored on Windows */, &read_mask, &write_mask, &except_mask, tv_p);
-#ifdef _WIN32
+  const int r = ::select(0 /* ignored */, &read_mask, &write_mask, &except_mask, tv_p);
   if (r == SOCKET_ERROR) {
     // TODO: throw Wsa_error;
     const int err = ::WSAGetLastError();
     throw std::system_error(err, std::system_category());
   }
+
+  auto result = Socket_readiness::unready;
+  if (r > 0) {
+    if (FD_ISSET(sock, &read_mask))
+      result |= Socket_readiness::read_ready;
+
+    if (FD_ISSET(sock, &write_mask))
+      result |= Socket_readiness::write_ready;
+
+    if (FD_ISSET(sock, &except_mask))
+      result |= Socket_readiness::exceptions;
+  }
 #else
+  /*
+   * Unlike select(2), poll(2) is not limited by FD_SETSIZE and its cost does
+   * not depend on the value of the descriptor. (Polling of a single descriptor
+   * by epoll(7) would just require more system calls.)
+   */
+  using Timeout = decltype (timeout.count());
+  constexpr Timeout max_timeout = std::numeric_limits<int>::max();
+  const int timeout_ms = timeout.count() < 0 ? -1 : static_cast<int>(std::min(timeout.count(), max_timeout));
+
+  pollfd pfd{};
+  pfd.fd = sock;
+  if (static_cast<Ut>(mask & Socket_readiness::read_ready))
+    pfd.events |= POLLIN;
+
+  if (static_cast<Ut>(mask & Socket_readiness::write_ready))
+    pfd.events |= POLLOUT;
+
+  if (static_cast<Ut>(mask & Socket_readiness::exceptions))
+    pfd.events |= POLLPRI;
+
+  const int r = ::poll(&pfd, 1, timeout_ms);
   if (r < 0) {
     /*
      * Note: errno is thread-local as explained at
@@ -1192,20 +1229,22 @@ DMITIGR_UTIL_INLINE Socket_readiness poll(const Socket_native socket,
      */
     const int err = errno;
     throw std::system_error(err, std::system_category());
-  }
-#endif
+  } else if (pfd.revents & POLLNVAL)
+    throw std::system_error(EBADF, std::system_category());
 
+  // The readiness is reported just like select(2) does.
   auto result = Socket_readiness::unready;
   if (r > 0) {
-    if (FD_ISSET(sock, &read_mask))
+    if (static_cast<Ut>(mask & Socket_readiness::read_ready) && (pfd.revents & (POLLIN | POLLHUP | POLLERR)))
       result |= Socket_readiness::read_ready;
 
-    if (FD_ISSET(sock, &write_mask))
+    if (static_cast<Ut>(mask & Socket_readiness::write_ready) && (pfd.revents & (POLLOUT | POLLERR)))
       result |= Socket_readiness::write_ready;
 
-    if (FD_ISSET(sock, &except_mask))
+    if (pfd.revents & POLLPRI)
       result |= Socket_readiness::exceptions;
   }
+#endif
 
   return result;
 }
@@ -449,7 +449,8 @@ DMITIGR_UTIL_API bool is_hostname_valid(const std::string& hostname);
  * @remarks
  * `(timeout < 0)` means *no timeout* and the function can block indefinitely!
  *
- * @remarks The current implementation is based only on select().
+ * @remarks The current implementation is based on poll() (and on select() on
+ * Windows), so the values of the descriptors are not limited by `FD_SETSIZE`.
  */
 DMITIGR_UTIL_API Socket_readiness poll(Socket_native socket,
   Socket_readiness mask, std::chrono::milliseconds timeout);
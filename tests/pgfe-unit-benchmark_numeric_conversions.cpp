@@ -0,0 +1,88 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "unit.hpp"
+
+#include <dmitigr/pgfe/conversions.hpp>
+#include <dmitigr/pgfe/data.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+  namespace pgfe = dmitigr::pgfe;
+  namespace chrono = std::chrono;
+  using namespace dmitigr::test;
+
+  try {
+    const unsigned long iteration_count = (argc >= 2) ? std::stoul(argv[1]) : 100000;
+    using Counter = std::remove_const_t<decltype (iteration_count)>;
+
+    const std::vector<std::unique_ptr<pgfe::Data>> integers = [&]
+    {
+      std::vector<std::unique_ptr<pgfe::Data>> result;
+      for (const char* const text : {"0", "-1", "42", "2147483647", "-2147483648", "65536"})
+        result.push_back(pgfe::Data::make(text));
+      return result;
+    }();
+
+    const std::vector<std::unique_ptr<pgfe::Data>> floats = [&]
+    {
+      std::vector<std::unique_ptr<pgfe::Data>> result;
+      for (const char* const text : {"0", "-1.5", "3.14159265358979", "1e-10", "6.02214076e+23", "0.1"})
+        result.push_back(pgfe::Data::make(text));
+      return result;
+    }();
+
+    const auto report = [&argv](const char* const what, const chrono::steady_clock::time_point started)
+    {
+      const auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - started);
+      std::cout << argv[0] << ": " << what << ": " << elapsed.count() << " ms" << std::endl;
+    };
+
+    // Text to integer
+    {
+      long long sum{};
+      const auto started = chrono::steady_clock::now();
+      for (Counter i = 0; i < iteration_count; ++i) {
+        for (const auto& d : integers)
+          sum += pgfe::to<int>(d.get());
+      }
+      report("to<int>", started);
+      ASSERT(sum == static_cast<long long>(iteration_count) * (0 - 1 + 42 + 2147483647LL - 2147483648LL + 65536));
+    }
+
+    // Text to double
+    {
+      double sum{};
+      const auto started = chrono::steady_clock::now();
+      for (Counter i = 0; i < iteration_count; ++i) {
+        for (const auto& d : floats)
+          sum += pgfe::to<double>(d.get());
+      }
+      report("to<double>", started);
+      ASSERT(sum != 0);
+    }
+
+    // Integer and double to text
+    {
+      std::size_t size{};
+      const auto started = chrono::steady_clock::now();
+      for (Counter i = 0; i < iteration_count; ++i) {
+        size += pgfe::to_data(static_cast<int>(i))->size();
+        size += pgfe::to_data(static_cast<double>(i) / 3)->size();
+      }
+      report("to_data(int), to_data(double)", started);
+      ASSERT(size > 0);
+    }
+  } catch (const std::exception& e) {
+    report_failure(argv[0], e);
+    return 1;
+  } catch (...) {
+    report_failure(argv[0]);
+    return 1;
+  }
+}
@@ -4,28 +4,100 @@
 
 #include "unit.hpp"
 
+#include <dmitigr/pgfe/composite.hpp>
 #include <dmitigr/pgfe/sql_string.hpp>
+#include <dmitigr/pgfe/sql_vector.hpp>
+
+#include <chrono>
+#include <string>
 
 int main(int argc, char* argv[])
 {
   namespace pgfe = dmitigr::pgfe;
+  namespace chrono = std::chrono;
   using namespace dmitigr::test;
 
   try {
     const unsigned long iteration_count = (argc >= 2) ? std::stoul(argv[1]) : 1;
-    std::unique_ptr<pgfe::Sql_string> s;
     using Counter = std::remove_const_t<decltype (iteration_count)>;
-    for (Counter i = 0; i < iteration_count; ++i) {
-      s = pgfe::Sql_string::make("SELECT :list_"
-                                 " FROM :t1_ t1 JOIN :t2_ t2 ON (t1.t2 = t2.id)"
-                                 " WHERE :where_");
-
-      s->replace_parameter("list_", "t1.id id, t1.age age, t2.dat dat");
-      s->replace_parameter("t1_", "table1");
-      s->replace_parameter("t2_", "table2");
-      s->replace_parameter("where_", "t1.nm = :nm AND t2.age = :age");
+
+    const auto report = [&argv](const char* const what, const chrono::steady_clock::time_point started)
+    {
+      const auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - started);
+      std::cout << argv[0] << ": " << what << ": " << elapsed.count() << " ms" << std::endl;
+    };
+
+    // Replacement of parameters
+    {
+      std::unique_ptr<pgfe::Sql_string> s;
+      const auto started = chrono::steady_clock::now();
+      for (Counter i = 0; i < iteration_count; ++i) {
+        s = pgfe::Sql_string::make("SELECT :list_"
+                                   " FROM :t1_ t1 JOIN :t2_ t2 ON (t1.t2 = t2.id)"
+                                   " WHERE :where_");
+
+        s->replace_parameter("list_", "t1.id id, t1.age age, t2.dat dat");
+        s->replace_parameter("t1_", "table1");
+        s->replace_parameter("t2_", "table2");
+        s->replace_parameter("where_", "t1.nm = :nm AND t2.age = :age");
+      }
+      report("replace_parameter()", started);
+      const auto modified_string = s->to_string();
+      ASSERT(s->parameter_count() == 2);
+    }
+
+    // Rendering of the query string
+    {
+      const auto s = pgfe::Sql_string::make("SELECT :a, :b FROM t WHERE :c = :a AND :d = $1");
+      std::size_t size{};
+      const auto started = chrono::steady_clock::now();
+      for (Counter i = 0; i < iteration_count * 100; ++i)
+        size += s->to_query_string().size();
+      report("to_query_string()", started);
+      ASSERT(size > 0);
+    }
+
+    // Parsing of the SQL input like the one of the Sql_vector files
+    {
+      std::string input;
+      constexpr int snippet_count = 100;
+      for (int i = 0; i < snippet_count; ++i) {
+        const auto n = std::to_string(i);
+        input.append("-- $id$query_").append(n).append("$id$\n"
+          "/*\n"
+          " * $description$\n"
+          " * The query number ").append(n).append(".\n"
+          " * $description$\n"
+          " */\n"
+          "SELECT t.id, t.name, t.\"Created At\", 'it''s a literal' AS literal\n"
+          "  FROM some_schema.some_table t\n"
+          "  JOIN other_schema.other_table o ON (o.id = t.other_id)\n"
+          " WHERE t.name = :name AND t.age > $1 AND o.kind = ANY(:kinds)\n"
+          "   AND t.flags[1:2] = $tag${}$tag$::int[];\n");
+      }
+      input.pop_back(); // the trailing newline would be parsed as the extra SQL string
+
+      std::size_t size{};
+      const auto started = chrono::steady_clock::now();
+      for (Counter i = 0; i < iteration_count; ++i)
+        size += pgfe::Sql_vector::make(input)->sql_string_count();
+      report("Sql_vector::make()", started);
+      ASSERT(size == iteration_count * snippet_count);
+      ASSERT(pgfe::Sql_vector::make(input)->sql_string("id", "query_42")->extra()->has_field("description"));
+
+      // Lookup by the extra data field
+      const auto vector = pgfe::Sql_vector::make(input);
+      for (const bool is_indexed : {false, true}) {
+        if (is_indexed)
+          vector->set_indexed_extra_name("id");
+        std::size_t sum{};
+        const auto started = chrono::steady_clock::now();
+        for (Counter i = 0; i < iteration_count * 100; ++i)
+          sum += *vector->sql_string_index("id", "query_" + std::to_string(i % snippet_count));
+        report(is_indexed ? "sql_string_index() (indexed)" : "sql_string_index()", started);
+        ASSERT(sum == iteration_count * 100 * (snippet_count - 1) / 2);
+      }
     }
-    const auto modified_string = s->to_string();
   } catch (const std::exception& e) {
     report_failure(argv[0], e);
     return 1;
@@ -6,13 +6,20 @@
 
 #include <dmitigr/pgfe/completion.hpp>
 #include <dmitigr/pgfe/connection.hpp>
+#include <dmitigr/pgfe/copier.hpp>
 #include <dmitigr/pgfe/error.hpp>
 #include <dmitigr/pgfe/notice.hpp>
 #include <dmitigr/pgfe/notification.hpp>
 #include <dmitigr/pgfe/row.hpp>
+#include <dmitigr/pgfe/row_info.hpp>
+#include <dmitigr/pgfe/row_set.hpp>
+#include <dmitigr/pgfe/sql_string.hpp>
+#include <dmitigr/pgfe/sql_vector.hpp>
 
 #include <cstring>
+#include <string>
 #include <thread>
+#include <vector>
 
 int main(int, char* argv[])
 {
@@ -271,9 +278,17 @@ int main(int, char* argv[])
           ASSERT(conn->is_ready_for_async_request());
           ASSERT(conn->is_ready_for_request());
 
+          // Registry statistics
+          const auto count = conn->prepared_statement_count();
+          const auto memory_usage = conn->prepared_statement_memory_usage();
+          ASSERT(count >= 2); // the unnamed and ps1
+          ASSERT(memory_usage > 0);
+
           // Unprepare
           conn->unprepare_statement("ps1");
           ASSERT(!conn->prepared_statement("ps1"));
+          ASSERT(conn->prepared_statement_count() == count - 1);
+          ASSERT(conn->prepared_statement_memory_usage() < memory_usage);
           ASSERT(conn->is_response_available());
           ASSERT(conn->completion() && (conn->completion()->operation_name() == "unprepare_statement"));
           ASSERT(!conn->is_awaiting_response());
@@ -370,6 +385,240 @@ int main(int, char* argv[])
         }
       }
 
+      // Pipeline
+      {
+        ASSERT(!conn->is_pipeline_enabled());
+        conn->set_pipeline_enabled(true);
+        ASSERT(conn->is_pipeline_enabled());
+
+        auto* const ps = conn->prepare_statement("SELECT $1::integer AS num", "pipeline_ps");
+        ASSERT(ps);
+        conn->dismiss_response();
+        for (int i = 1; i <= 3; ++i) {
+          ps->set_parameter(0, i);
+          ps->execute_async();
+          ASSERT(conn->is_ready_for_async_request());
+          ASSERT(!conn->is_ready_for_request());
+        }
+        conn->perform_async("PROVOKE SYNTAX ERROR");
+        conn->perform_async("SELECT 1");
+        conn->synchronize_pipeline_async();
+
+        for (int i = 1; i <= 3; ++i) {
+          conn->wait_response();
+          ASSERT(conn->row());
+          ASSERT(std::stoi(conn->row()->data("num")->bytes()) == i);
+          conn->dismiss_response();
+          conn->wait_response();
+          ASSERT(conn->completion() && conn->completion()->operation_name() == "SELECT");
+          conn->dismiss_response();
+        }
+        conn->wait_response();
+        ASSERT(conn->error() && conn->error()->code() == pgfe::Server_errc::c42_syntax_error);
+        conn->dismiss_response();
+        conn->wait_response();
+        ASSERT(conn->completion() && conn->completion()->operation_name() == "pipeline_aborted");
+        conn->dismiss_response();
+        conn->wait_response();
+        ASSERT(conn->completion() && conn->completion()->operation_name() == "pipeline_sync");
+        conn->dismiss_response();
+        ASSERT(!conn->is_awaiting_response());
+        ASSERT(conn->is_ready_for_request());
+
+        conn->unprepare_statement("pipeline_ps");
+        conn->set_pipeline_enabled(false);
+        ASSERT(!conn->is_pipeline_enabled());
+      }
+
+      // Prepared statements cache
+      {
+        ASSERT(conn->prepared_statement_cache_capacity() == 0);
+        ASSERT(conn->prepared_statement_cache_size() == 0);
+        ASSERT(is_logic_throw_works([&]{ conn->cached_prepared_statement("SELECT 1"); }));
+
+        conn->set_prepared_statement_cache_capacity(2);
+        ASSERT(conn->prepared_statement_cache_capacity() == 2);
+
+        auto* const ps1 = conn->cached_prepared_statement("SELECT $1::integer");
+        ASSERT(ps1 && !ps1->name().empty());
+        ASSERT(conn->prepared_statement(ps1->name()) == ps1);
+        ASSERT(conn->cached_prepared_statement("SELECT $1::integer") == ps1);
+        ASSERT(conn->prepared_statement_cache_size() == 1);
+
+        conn->execute("SELECT $1::integer", 7);
+        ASSERT(conn->row() && pgfe::to<int>(conn->row()->data(0)) == 7);
+        conn->complete();
+        ASSERT(conn->prepared_statement_cache_size() == 1);
+
+        // The current formats of the connection are applied upon cache hit.
+        conn->set_result_format(pgfe::Data_format::binary);
+        conn->execute("SELECT $1::integer", 7);
+        ASSERT(conn->row() && conn->row()->data(0)->format() == pgfe::Data_format::binary);
+        conn->complete();
+        conn->set_result_format(pgfe::Data_format::text);
+        ASSERT(conn->cached_prepared_statement("SELECT $1::integer")->result_format() == pgfe::Data_format::text);
+
+        const auto s2 = pgfe::Sql_string::make("SELECT :n::integer");
+        auto* const ps2 = conn->cached_prepared_statement(s2.get());
+        ASSERT(ps2 && ps2 != ps1);
+        ASSERT(conn->prepared_statement_cache_size() == 2);
+
+        // ps1 is the most recently used.
+        ASSERT(conn->cached_prepared_statement("SELECT $1::integer") == ps1);
+
+        // ps2 is evicted.
+        const auto ps2_name = ps2->name();
+        auto* const ps3 = conn->cached_prepared_statement("SELECT 3");
+        ASSERT(ps3);
+        ASSERT(!conn->prepared_statement(ps2_name));
+        ASSERT(conn->prepared_statement_cache_size() == 2);
+
+        // Unpreparing removes from the cache.
+        conn->unprepare_statement(ps3->name());
+        ASSERT(conn->prepared_statement_cache_size() == 1);
+
+        const auto ps1_name = ps1->name();
+        conn->set_prepared_statement_cache_capacity(0);
+        ASSERT(conn->prepared_statement_cache_size() == 0);
+        ASSERT(!conn->prepared_statement(ps1_name));
+
+        conn->execute("SELECT $1::integer", 8);
+        ASSERT(conn->row() && pgfe::to<int>(conn->row()->data(0)) == 8);
+        conn->complete();
+      }
+
+      // Row set
+      {
+        ASSERT(conn->row_processing() == pgfe::Row_processing::single);
+        conn->set_row_processing(pgfe::Row_processing::batch);
+        ASSERT(conn->row_processing() == pgfe::Row_processing::batch);
+
+        conn->perform("SELECT generate_series(1, 3) AS num, NULL::text AS nul");
+        const auto* const rs = conn->row_set();
+        ASSERT(rs);
+        ASSERT(!conn->row());
+        ASSERT(rs->row_count() == 3);
+        ASSERT(rs->info()->field_count() == 2);
+        for (std::size_t i = 0; i < rs->row_count(); ++i) {
+          ASSERT(pgfe::to<int>(rs->data(i, 0)) == int(i + 1));
+          ASSERT(pgfe::to<int>(rs->data(i, "num")) == int(i + 1));
+          ASSERT(!rs->data(i, "nul"));
+        }
+        ASSERT(is_logic_throw_works([&]{ rs->data(3, 0); }));
+        ASSERT(is_logic_throw_works([&]{ conn->for_each([](const pgfe::Row*){}); }));
+        ASSERT(rs == conn->row_set());
+        conn->dismiss_response();
+        conn->wait_response();
+        ASSERT(conn->completion() && conn->completion()->operation_name() == "SELECT");
+        conn->dismiss_response();
+        ASSERT(!conn->is_awaiting_response());
+
+        // Empty result produces only the Completion.
+        conn->perform("SELECT 1 WHERE false");
+        ASSERT(!conn->row_set());
+        ASSERT(conn->completion() && conn->completion()->operation_name() == "SELECT");
+        ASSERT(!conn->is_awaiting_response());
+
+        auto* const ps = conn->prepare_statement("SELECT generate_series(1, $1::integer)");
+        ps->set_parameter(0, 100);
+        ps->execute();
+        auto rs_released = conn->release_row_set();
+        ASSERT(rs_released && rs_released->row_count() == 100);
+        ASSERT(!conn->row_set());
+        conn->complete();
+
+        conn->set_row_processing(pgfe::Row_processing::single);
+        conn->perform("SELECT 1");
+        ASSERT(conn->row() && !conn->row_set());
+        conn->complete();
+      }
+
+      // Field lookup by names
+      {
+        const auto* const query =
+          "SELECT 0 a, 1 b, 2 a, 3 c, 4 d, 5 e, 6 f, 7 g, 8 h, 9 i, 10 \"A\", 11 a";
+        auto* const ps = conn->prepare_statement(query, "field_lookup");
+        for (int i = 0; i < 2; ++i) {
+          ps->execute();
+          const auto* const r = conn->row();
+          ASSERT(r && r->field_count() == 12);
+          ASSERT(r->field_index("a") == 0);
+          ASSERT(r->field_index("a", 1) == 2);
+          ASSERT(r->field_index("a", 3) == 11);
+          ASSERT(r->field_index("A", 3) == 11);
+          ASSERT(r->field_index("\"A\"") == 10);
+          ASSERT(r->field_index("i") == 9);
+          ASSERT(!r->field_index("z"));
+          ASSERT(!r->field_index("b", 2));
+          ASSERT(pgfe::to<int>(r->data("h")) == 8);
+          conn->complete();
+        }
+        conn->unprepare_statement("field_lookup");
+      }
+
+      // Copy
+      {
+        conn->perform("CREATE TEMP TABLE copy_test(id integer, name text)");
+
+        // COPY FROM STDIN (text)
+        conn->perform("COPY copy_test FROM STDIN");
+        auto* copier = conn->copier();
+        ASSERT(copier && copier->is_active());
+        ASSERT(copier->data_direction() == pgfe::Data_direction::to_server);
+        ASSERT(copier->data_format() == pgfe::Data_format::text);
+        ASSERT(copier->field_count() == 2);
+        ASSERT(!conn->is_ready_for_async_request());
+        copier->send("1\tone\n");
+        copier->send_row(2, "tab\tand\\backslash");
+        copier->send_row(3, nullptr);
+        ASSERT(is_logic_throw_works([&]{ copier->send_row(4); }));
+        copier->end();
+        ASSERT(!copier->is_active() && !conn->copier());
+        conn->wait_response_throw();
+        ASSERT(conn->completion() && conn->completion()->operation_name() == "COPY");
+        ASSERT(conn->completion()->affected_row_count() == "3");
+        conn->dismiss_response();
+
+        // COPY FROM STDIN (binary)
+        conn->perform("COPY copy_test FROM STDIN (FORMAT binary)");
+        copier = conn->copier();
+        ASSERT(copier && copier->data_format() == pgfe::Data_format::binary);
+        const char id[] = {0, 0, 0, 4};
+        copier->send_row(pgfe::Data::make(id, sizeof(id), pgfe::Data_format::binary),
+          pgfe::Data::make("four", 4, pgfe::Data_format::binary));
+        copier->end();
+        conn->wait_response_throw();
+        ASSERT(conn->completion() && conn->completion()->affected_row_count() == "1");
+
+        // COPY FROM STDIN (binary, no rows)
+        conn->perform("COPY copy_test FROM STDIN (FORMAT binary)");
+        conn->copier()->end();
+        conn->wait_response_throw();
+        ASSERT(conn->completion() && conn->completion()->affected_row_count() == "0");
+
+        // COPY FROM STDIN (error)
+        conn->perform("COPY copy_test FROM STDIN");
+        conn->copier()->end("aborted by the test");
+        conn->wait_response();
+        ASSERT(conn->error());
+        conn->dismiss_response();
+
+        // COPY TO STDOUT
+        conn->perform("COPY (SELECT * FROM copy_test ORDER BY id) TO STDOUT");
+        copier = conn->copier();
+        ASSERT(copier && copier->data_direction() == pgfe::Data_direction::from_server);
+        std::vector<std::string> rows;
+        while (const auto data = copier->receive())
+          rows.emplace_back(data->bytes(), data->size());
+        ASSERT(!conn->copier());
+        ASSERT((rows == std::vector<std::string>{"1\tone\n", "2\ttab\\tand\\\\backslash\n",
+          "3\t\\N\n", "4\tfour\n"}));
+        conn->wait_response_throw();
+        ASSERT(conn->completion() && conn->completion()->affected_row_count() == "4");
+        conn->dismiss_response();
+        ASSERT(conn->is_ready_for_request());
+      }
+
       // Result format
       {
         ASSERT(conn->result_format() == pgfe::Data_format::text);
@@ -385,6 +634,33 @@ int main(int, char* argv[])
         ASSERT(conn->result_format() == pgfe::Data_format::text);
       }
 
+      // Parameter format
+      {
+        ASSERT(conn->parameter_format() == pgfe::Data_format::text);
+        conn->set_parameter_format(pgfe::Data_format::binary);
+        ASSERT(conn->parameter_format() == pgfe::Data_format::binary);
+        auto* const ps = conn->prepare_statement("SELECT $1::integer, $2::float8, $3::boolean, $4::text");
+        ASSERT(ps->parameter_format() == pgfe::Data_format::binary);
+        ps->set_parameters(-7, 2.5, true, std::string{"text"});
+        ASSERT(ps->parameter(0)->format() == pgfe::Data_format::binary);
+        ASSERT(ps->parameter(1)->format() == pgfe::Data_format::binary);
+        ASSERT(ps->parameter(2)->format() == pgfe::Data_format::binary);
+        ASSERT(ps->parameter(3)->format() == pgfe::Data_format::text);
+        ps->execute();
+        ASSERT(conn->row());
+        ASSERT(pgfe::to<int>(conn->row()->data(0)) == -7);
+        ASSERT(pgfe::to<double>(conn->row()->data(1)) == 2.5);
+        ASSERT(pgfe::to<bool>(conn->row()->data(2)) == true);
+        ASSERT(pgfe::to<std::string>(conn->row()->data(3)) == "text");
+        conn->dismiss_response();
+        conn->wait_response_throw();
+
+        ps->set_parameter_format(pgfe::Data_format::text);
+        ps->set_parameter(0, 7);
+        ASSERT(ps->parameter(0)->format() == pgfe::Data_format::text);
+        conn->set_parameter_format(pgfe::Data_format::text);
+      }
+
       // to_quoted_literal(), to_quoted_identifier()
       {
         const std::string s{"the string"};
@@ -403,6 +679,138 @@ int main(int, char* argv[])
 
         ASSERT(std::string(hex_data->bytes()) == conn->to_hex_string(data.get()));
       }
+
+      // Instrumentation
+      {
+        ASSERT(!conn->request_start_handler());
+        ASSERT(!conn->request_finish_handler());
+        conn->reset_statistics();
+        ASSERT(conn->statistics().request_count == 0);
+
+        std::vector<pgfe::Request_info> started;
+        std::vector<pgfe::Request_info> finished;
+        conn->set_request_start_handler([&](const pgfe::Request_info& info) { started.push_back(info); });
+        conn->set_request_finish_handler([&](const pgfe::Request_info& info) { finished.push_back(info); });
+        ASSERT(conn->request_start_handler());
+        ASSERT(conn->request_finish_handler());
+
+        conn->perform("SELECT generate_series(1, 3)");
+        conn->complete();
+        ASSERT(started.size() == 1 && finished.size() == 1);
+        ASSERT(started[0].query == "SELECT generate_series(1, 3)");
+        ASSERT(finished[0].query == started[0].query);
+        ASSERT(finished[0].row_count == 3);
+        ASSERT(finished[0].byte_count == 3);
+        ASSERT(!finished[0].is_failed);
+
+        auto* const ps = conn->prepare_statement("SELECT $1::integer", "instrumented");
+        ps->set_parameter(0, 7);
+        ps->execute();
+        conn->complete();
+        ASSERT(started.size() == 3 && finished.size() == 3);
+        ASSERT(finished[1].name == "instrumented");
+        ASSERT(finished[1].query == "SELECT $1::integer");
+        ASSERT(finished[2].name == "instrumented");
+        ASSERT(finished[2].parameter_count == 1);
+        ASSERT(finished[2].row_count == 1);
+
+        ASSERT(is_runtime_throw_works([&]{ conn->perform("SELECT 1/0"); }));
+        if (conn->is_awaiting_response())
+          conn->wait_last_response();
+        ASSERT(finished.size() == 4 && finished[3].is_failed);
+
+        const auto& stats = conn->statistics();
+        ASSERT(stats.request_count == 4);
+        ASSERT(stats.error_count == 1);
+        ASSERT(stats.row_count == 4);
+        std::uint_fast64_t histogram_total{};
+        for (const auto count : stats.duration_histogram)
+          histogram_total += count;
+        ASSERT(histogram_total == stats.request_count);
+
+        conn->set_request_start_handler({});
+        conn->set_request_finish_handler({});
+        conn->perform("SELECT 1");
+        ASSERT(finished.size() == 4);
+        ASSERT(conn->statistics().request_count == 5);
+        conn->unprepare_statement("instrumented");
+
+        // The awaited requests are finished as failed upon disconnection.
+        const auto other = pgfe::test::make_connection();
+        other->connect();
+        std::size_t failed_count{};
+        other->set_request_start_handler([](const pgfe::Request_info&) {});
+        other->set_request_finish_handler([&](const pgfe::Request_info& info)
+        {
+          failed_count += info.is_failed;
+          throw std::runtime_error{"the exception of the handler is ignored"};
+        });
+        other->set_pipeline_enabled(true);
+        other->perform_async("SELECT pg_sleep(0.1)");
+        other->perform_async("SELECT 1");
+        other->disconnect();
+        ASSERT(failed_count == 2);
+      }
+
+      // Statement manifest
+      {
+        ASSERT(!conn->statement_manifest());
+        const auto sql_vector = pgfe::Sql_vector::make(
+          "-- $id$manifest_plus_one$id$\n"
+          "SELECT :n::integer + 1;\n"
+          "-- $id$manifest_concat$id$\n"
+          "SELECT $1::text || $2::text;\n"
+          "SELECT 'without name'");
+        ASSERT(is_logic_throw_works([&]{ pgfe::to_statement_manifest(*sql_vector, ""); }));
+        const auto manifest = pgfe::to_statement_manifest(*sql_vector, "id");
+        ASSERT(manifest->size() == 2);
+        ASSERT(manifest->front().first == "manifest_plus_one");
+
+        // Setting the manifest to the connected connection prepares it at once.
+        conn->set_statement_manifest(manifest);
+        ASSERT(conn->statement_manifest() == manifest);
+        ASSERT(conn->prepared_statement("manifest_plus_one"));
+        ASSERT(conn->prepared_statement("manifest_concat"));
+        ASSERT(!conn->is_pipeline_enabled());
+
+        // The statements already prepared are replaced.
+        conn->set_statement_manifest(manifest);
+        ASSERT(conn->prepared_statement("manifest_plus_one"));
+        ASSERT(conn->prepared_statement("manifest_concat"));
+
+        // The manifest is prepared again upon reconnection.
+        conn->disconnect();
+        ASSERT(!conn->prepared_statement("manifest_plus_one"));
+        conn->connect();
+        auto* const ps = conn->prepared_statement("manifest_plus_one");
+        ASSERT(ps);
+        ps->set_parameter("n", 2);
+        ps->execute();
+        ASSERT(pgfe::to<int>(conn->row()->data(0)) == 3);
+        conn->complete();
+        ASSERT(conn->prepared_statement("manifest_concat"));
+
+        // The erroneous statement.
+        const auto bad_manifest = pgfe::to_statement_manifest(*pgfe::Sql_vector::make(
+          "-- $id$manifest_bad$id$\n"
+          "SELECT * FROM pgfe_no_such_table;\n"
+          "-- $id$manifest_good$id$\n"
+          "SELECT 1"), "id");
+        ASSERT(is_runtime_throw_works([&]{ conn->set_statement_manifest(bad_manifest); }));
+        ASSERT(conn->is_ready_for_request());
+        ASSERT(!conn->prepared_statement("manifest_bad"));
+
+        // The connection is closed if the manifest is failed to prepare upon connect().
+        conn->disconnect();
+        ASSERT(is_runtime_throw_works([&]{ conn->connect(); }));
+        ASSERT(!conn->is_connected());
+
+        conn->set_statement_manifest(nullptr);
+        ASSERT(!conn->statement_manifest());
+        conn->disconnect();
+        conn->connect();
+        ASSERT(!conn->prepared_statement("manifest_plus_one"));
+      }
     }
   } catch (const std::exception& e) {
     report_failure(argv[0], e);
@@ -0,0 +1,164 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "pgfe-unit.hpp"
+
+#include <dmitigr/pgfe/completion.hpp>
+#include <dmitigr/pgfe/connection_pool.hpp>
+#include <dmitigr/pgfe/exceptions.hpp>
+#include <dmitigr/pgfe/row.hpp>
+#include <dmitigr/pgfe/sql_vector.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+int main(int, char* argv[])
+{
+  namespace pgfe = dmitigr::pgfe;
+  using namespace dmitigr::test;
+  using namespace std::chrono_literals;
+
+  try {
+    ASSERT(is_logic_throw_works([]{ pgfe::Connection_pool::make(nullptr, 0); }));
+
+    const auto conn_opts = pgfe::test::connection_options();
+    auto pool = pgfe::Connection_pool::make(conn_opts.get(), 2);
+    ASSERT(pool);
+    ASSERT(pool->options() && pool->options() != conn_opts.get());
+    ASSERT(pool->max_size() == 2);
+    ASSERT(pool->size() == 0);
+    ASSERT(pool->idle_count() == 0);
+    ASSERT(!pool->idle_timeout());
+    ASSERT(!pool->max_lifetime());
+
+    // Connections are opened lazily and reused.
+    {
+      std::int_fast32_t pid{};
+      {
+        const auto conn = pool->connection();
+        ASSERT(conn && conn->is_connected());
+        ASSERT(pool->size() == 1 && pool->idle_count() == 0);
+        pid = *conn->server_pid();
+      }
+      ASSERT(pool->size() == 1 && pool->idle_count() == 1);
+
+      const auto conn = pool->connection();
+      ASSERT(*conn->server_pid() == pid);
+      ASSERT(pool->size() == 1 && pool->idle_count() == 0);
+    }
+    ASSERT(pool->idle_count() == 1);
+
+    // Exhaustion.
+    {
+      const auto conn1 = pool->connection();
+      const auto conn2 = pool->connection();
+      ASSERT(pool->size() == 2 && pool->idle_count() == 0);
+      try {
+        pool->connection(10ms);
+        ASSERT(false);
+      } catch (const pgfe::Client_exception& e) {
+        ASSERT(e.code() == pgfe::Client_errc::timed_out);
+      }
+      ASSERT(pool->size() == 2);
+    }
+    ASSERT(pool->size() == 2 && pool->idle_count() == 2);
+
+    // The connection with the uncommitted transaction is not reused.
+    {
+      {
+        const auto conn = pool->connection();
+        conn->perform("BEGIN");
+      }
+      ASSERT(pool->size() == 1 && pool->idle_count() == 1);
+    }
+
+    // The connection with the unprocessed rows is not reused.
+    {
+      {
+        const auto conn = pool->connection();
+        conn->perform("SELECT generate_series(1, 3)");
+        ASSERT(conn->row());
+      }
+      ASSERT(pool->size() == 0 && pool->idle_count() == 0);
+    }
+
+    // Idle timeout and max lifetime.
+    {
+      const auto pid = *pool->connection()->server_pid();
+      ASSERT(pool->size() == 1 && pool->idle_count() == 1);
+      pool->set_idle_timeout(0ms);
+      ASSERT(pool->idle_timeout() == 0ms);
+      ASSERT(*pool->connection()->server_pid() != pid);
+      ASSERT(pool->size() == 1 && pool->idle_count() == 1);
+      pool->set_idle_timeout(std::nullopt);
+
+      pool->set_max_lifetime(0ms);
+      ASSERT(pool->max_lifetime() == 0ms);
+      pool->connection();
+      ASSERT(pool->size() == 0 && pool->idle_count() == 0);
+      pool->set_max_lifetime(std::nullopt);
+    }
+
+    // Clear.
+    {
+      pool->connection();
+      ASSERT(pool->idle_count() == 1);
+      pool->clear();
+      ASSERT(pool->size() == 0 && pool->idle_count() == 0);
+    }
+
+    // Connections can outlive the pool.
+    {
+      auto conn = pool->connection();
+      pool.reset();
+      conn->perform("SELECT 1");
+      conn->complete();
+    }
+
+    // Statement manifest.
+    {
+      pool = pgfe::Connection_pool::make(conn_opts.get(), 1);
+      const auto manifest = pgfe::to_statement_manifest(
+        *pgfe::Sql_vector::make("-- $id$pool_two$id$\nSELECT 2"), "id");
+      pool->set_statement_manifest(manifest);
+      ASSERT(pool->statement_manifest() == manifest);
+      const auto conn = pool->connection();
+      ASSERT(conn->statement_manifest() == manifest);
+      auto* const ps = conn->prepared_statement("pool_two");
+      ASSERT(ps);
+      ps->execute();
+      ASSERT(pgfe::to<int>(conn->row()->data(0)) == 2);
+      conn->complete();
+    }
+
+    // Concurrency.
+    {
+      pool = pgfe::Connection_pool::make(conn_opts.get(), 4);
+      std::atomic<int> sum{};
+      std::vector<std::thread> workers;
+      for (int i = 0; i < 16; ++i) {
+        workers.emplace_back([&pool, &sum]
+        {
+          for (int j = 0; j < 10; ++j) {
+            const auto conn = pool->connection();
+            conn->perform("SELECT 1");
+            conn->for_each([&](const auto* const r) { sum += pgfe::to<int>(r->data(0)); });
+            conn->complete();
+          }
+        });
+      }
+      for (auto& w : workers)
+        w.join();
+      ASSERT(sum == 16 * 10);
+      ASSERT(pool->size() <= 4 && pool->size() == pool->idle_count());
+    }
+  } catch (const std::exception& e) {
+    report_failure(argv[0], e);
+    return 1;
+  } catch (...) {
+    report_failure(argv[0]);
+    return 1;
+  }
+}
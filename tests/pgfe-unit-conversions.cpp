@@ -12,6 +12,7 @@
 
 #include <dmitigr/pgfe/conversions.hpp>
 
+#include <cstring>
 #include <limits>
 #include <optional>
 #include <string>
@@ -127,6 +128,57 @@ int main(int, char* argv[])
       ASSERT(original == converted);
     }
 
+    // Numeric text parsing
+    {
+      ASSERT(pgfe::to<short>(pgfe::Data::make("-32768")) == numeric_limits<short>::min());
+      ASSERT(pgfe::to<int>(pgfe::Data::make(" +123")) == 123);
+      ASSERT(pgfe::to<long long>(pgfe::Data::make("-9223372036854775808")) == numeric_limits<long long>::min());
+      ASSERT(pgfe::to<double>(pgfe::Data::make("-1.5e3")) == -1500.0);
+      ASSERT(pgfe::to<double>(pgfe::Data::make("Infinity")) == numeric_limits<double>::infinity());
+      ASSERT(pgfe::to<float>(pgfe::Data::make("0.1")) == 0.1f);
+      ASSERT(pgfe::to_data(0.1)->bytes() == std::string{"0.1"});
+      ASSERT(pgfe::to_data(-42)->bytes() == std::string{"-42"});
+      ASSERT(is_logic_throw_works([]{ pgfe::to<short>(pgfe::Data::make("32768")); }));
+      ASSERT(is_logic_throw_works([]{ pgfe::to<int>(pgfe::Data::make("")); }));
+      ASSERT(is_logic_throw_works([]{ pgfe::to<int>(pgfe::Data::make("+-1")); }));
+      ASSERT(is_runtime_throw_works([]{ pgfe::to<int>(pgfe::Data::make("12ab")); }));
+      ASSERT(is_runtime_throw_works([]{ pgfe::to<double>(pgfe::Data::make("1.5 ")); }));
+    }
+
+    // Numeric and bool binary output
+    {
+      const auto int_data = pgfe::to_data(-2, pgfe::Data_format::binary);
+      ASSERT(int_data->format() == pgfe::Data_format::binary);
+      ASSERT(int_data->size() == 4);
+      ASSERT(std::memcmp(int_data->bytes(), "\xff\xff\xff\xfe", 4) == 0);
+      ASSERT(pgfe::to<int>(int_data.get()) == -2);
+
+      const auto short_data = pgfe::to_data(short(258), pgfe::Data_format::binary);
+      ASSERT(short_data->size() == 2 && std::memcmp(short_data->bytes(), "\x01\x02", 2) == 0);
+      ASSERT(pgfe::to<short>(short_data.get()) == 258);
+
+      const auto ll_data = pgfe::to_data(numeric_limits<long long>::min(), pgfe::Data_format::binary);
+      ASSERT(ll_data->size() == 8);
+      ASSERT(pgfe::to<long long>(ll_data.get()) == numeric_limits<long long>::min());
+
+      const auto float_data = pgfe::to_data(1.0f, pgfe::Data_format::binary);
+      ASSERT(float_data->size() == 4 && std::memcmp(float_data->bytes(), "\x3f\x80\x00\x00", 4) == 0);
+      ASSERT(pgfe::to<float>(float_data.get()) == 1.0f);
+
+      const auto double_data = pgfe::to_data(-0.5, pgfe::Data_format::binary);
+      ASSERT(double_data->size() == 8);
+      ASSERT(pgfe::to<double>(double_data.get()) == -0.5);
+
+      const auto bool_data = pgfe::to_data(true, pgfe::Data_format::binary);
+      ASSERT(bool_data->format() == pgfe::Data_format::binary);
+      ASSERT(bool_data->size() == 1 && bool_data->bytes()[0] == 1);
+      ASSERT(pgfe::to<bool>(bool_data.get()) == true);
+
+      ASSERT(pgfe::to_data(7, pgfe::Data_format::text)->format() == pgfe::Data_format::text);
+      ASSERT(is_logic_throw_works([]{ pgfe::to_data(1.0L, pgfe::Data_format::binary); }));
+      static_assert(pgfe::Is_binary_data_convertible_v<int> && !pgfe::Is_binary_data_convertible_v<std::string>);
+    }
+
     // char
     {
       char original = 'd';
@@ -226,6 +278,138 @@ int main(int, char* argv[])
       ASSERT(test_ok);
     }
 
+    // Binary arrays
+    {
+      // 1-dimensional array with NULL
+      {
+        const Vector_array<int> original{1, std::nullopt, -3};
+        const auto data = pgfe::to_data(original, pgfe::Data_format::binary);
+        ASSERT(data->format() == pgfe::Data_format::binary);
+        const unsigned char expected[] = {
+          0,0,0,1, 0,0,0,1, 0,0,0,23, // ndim, has null, int4
+          0,0,0,3, 0,0,0,1,           // size, lower bound
+          0,0,0,4, 0,0,0,1,           // 1
+          0xff,0xff,0xff,0xff,        // NULL
+          0,0,0,4, 0xff,0xff,0xff,0xfd};
+        ASSERT(data->size() == sizeof(expected));
+        ASSERT(std::memcmp(data->bytes(), expected, sizeof(expected)) == 0);
+        const auto converted = pgfe::to<Vector_array<int>>(data.get());
+        ASSERT(original == converted);
+      }
+
+      // 2-dimensional arrays
+      {
+        using Arr = Array<Array<long long, std::list>, std::vector>;
+        const Arr original{List_array<long long>{1, numeric_limits<long long>::min()},
+                           List_array<long long>{std::nullopt, numeric_limits<long long>::max()}};
+        const auto data = pgfe::to_data(original, pgfe::Data_format::binary);
+        const auto converted = pgfe::to<Arr>(data.get());
+        ASSERT(original == converted);
+      }
+      {
+        using Vec2 = std::vector<std::vector<std::string>>;
+        const Vec2 original{{"a", ""}, {"Dmitry", "Igrishin"}};
+        const auto data = pgfe::to_data(Vec2{original}, pgfe::Data_format::binary);
+        const auto converted = pgfe::to<Vec2>(data.get());
+        ASSERT(original == converted);
+      }
+
+      // Other element types
+      {
+        const Vector_array<short> original{numeric_limits<short>::min(), 0, numeric_limits<short>::max()};
+        ASSERT(original == pgfe::to<Vector_array<short>>(pgfe::to_data(original, pgfe::Data_format::binary)));
+      }
+      {
+        const Vector_array<double> original{-1.5, std::nullopt, numeric_limits<double>::max()};
+        ASSERT(original == pgfe::to<Vector_array<double>>(pgfe::to_data(original, pgfe::Data_format::binary)));
+      }
+      {
+        const Vector_array<float> original{3.25f, numeric_limits<float>::lowest()};
+        ASSERT(original == pgfe::to<Vector_array<float>>(pgfe::to_data(original, pgfe::Data_format::binary)));
+      }
+      {
+        const Vector_array<bool> original{true, false, std::nullopt};
+        ASSERT(original == pgfe::to<Vector_array<bool>>(pgfe::to_data(original, pgfe::Data_format::binary)));
+      }
+
+      // Empty array
+      {
+        const Vector_array<Vector_array<int>> original;
+        const auto data = pgfe::to_data(original, pgfe::Data_format::binary);
+        ASSERT(data->size() == 12);
+        ASSERT(pgfe::to<Vector_array<Vector_array<int>>>(data.get()).empty());
+      }
+
+      // Dimensionality mismatch
+      {
+        const auto data = pgfe::to_data(Vector_array<int>{1}, pgfe::Data_format::binary);
+        std::error_code code;
+        try {
+          pgfe::to<Vector_array<Vector_array<int>>>(data.get());
+        } catch (const pgfe::Client_exception& e) {
+          code = e.code();
+        }
+        ASSERT(code == pgfe::Client_errc::excessive_array_dimensionality);
+      }
+
+      // Element type mismatch
+      {
+        const auto data = pgfe::to_data(Vector_array<int>{1, 2}, pgfe::Data_format::binary);
+        ASSERT((pgfe::to<Vector_array<long long>>(data.get()) == Vector_array<long long>{1, 2}));
+        const auto check_improper = [](const auto& convert)
+        {
+          std::error_code code;
+          try {
+            convert();
+          } catch (const pgfe::Client_exception& e) {
+            code = e.code();
+          }
+          ASSERT(code == pgfe::Client_errc::improper_value_type_of_container);
+        };
+        check_improper([&]{ pgfe::to<Vector_array<float>>(data.get()); });
+        check_improper([&]{ pgfe::to<Vector_array<short>>(data.get()); });
+        check_improper([&]{ pgfe::to<std::vector<std::string>>(data.get()); });
+        check_improper([]{ pgfe::to<Vector_array<float>>(pgfe::to_data(Vector_array<double>{1},
+          pgfe::Data_format::binary)); });
+        ASSERT((pgfe::to<Vector_array<double>>(pgfe::to_data(Vector_array<float>{0.5f},
+          pgfe::Data_format::binary)) == Vector_array<double>{0.5}));
+      }
+
+      // Non-rectangular array
+      {
+        const Vector_array<Vector_array<int>> original{Vector_array<int>{1}, Vector_array<int>{1, 2}};
+        ASSERT(is_logic_throw_works([&]{ pgfe::to_data(original, pgfe::Data_format::binary); }));
+      }
+
+      // Malformed binary arrays
+      {
+        const auto data = pgfe::to_data(Vector_array<int>{1, 2}, pgfe::Data_format::binary);
+        for (std::size_t size = 1; size < data->size(); ++size) {
+          std::error_code code;
+          try {
+            pgfe::to<Vector_array<int>>(pgfe::Data::make(data->bytes(), size, pgfe::Data_format::binary));
+          } catch (const pgfe::Client_exception& e) {
+            code = e.code();
+          }
+          ASSERT(code == pgfe::Client_errc::malformed_binary_array);
+        }
+
+        // The zero inner dimension with the non-zero outer one.
+        const unsigned char zero_inner[] = {
+          0,0,0,2, 0,0,0,0, 0,0,0,23, // ndim, has null, int4
+          0x7f,0xff,0xff,0xff, 0,0,0,1, // size, lower bound
+          0,0,0,0, 0,0,0,1};
+        std::error_code code;
+        try {
+          pgfe::to<Vector_array<Vector_array<int>>>(pgfe::Data::make(reinterpret_cast<const char*>(zero_inner),
+            sizeof(zero_inner), pgfe::Data_format::binary));
+        } catch (const pgfe::Client_exception& e) {
+          code = e.code();
+        }
+        ASSERT(code == pgfe::Client_errc::malformed_binary_array);
+      }
+    }
+
     // Array literals
     {
       using Arr = Vector_array<int>;
@@ -5,11 +5,15 @@
 #include "pgfe-unit.hpp"
 
 #include <dmitigr/pgfe/conversions.hpp>
+#include <dmitigr/pgfe/record.hpp>
 #include <dmitigr/pgfe/row.hpp>
+#include <dmitigr/pgfe/row_mapper.hpp>
+#include <dmitigr/pgfe/row_set.hpp>
 #include <dmitigr/pgfe/sql_string.hpp>
 
 #include <optional>
 #include <string>
+#include <tuple>
 
 int main(int, char* argv[])
 {
@@ -127,6 +131,91 @@ int main(int, char* argv[])
       conn->dismiss_response();
       conn->wait_response();
     }
+
+    // row mapping
+    {
+      struct Person final {
+        int id;
+        std::string name;
+        std::optional<double> weight;
+      };
+
+      conn->execute("SELECT 1::integer, 'Dima'::text, NULL::double precision");
+      auto* r = conn->row();
+      ASSERT(r);
+      const auto t = to<std::tuple<int, std::string, std::optional<double>>>(r);
+      ASSERT(std::get<0>(t) == 1);
+      ASSERT(std::get<1>(t) == "Dima");
+      ASSERT(!std::get<2>(t));
+      ASSERT(is_runtime_throw_works([&]{ to<std::tuple<int, std::string, double>>(r); }));
+      conn->complete();
+
+      pgfe::Row_mapper<int, std::string, std::optional<double>> mapper{{"id", "name", "weight"}};
+      conn->execute("SELECT $1::double precision weight, 'P' || n AS name, n AS id"
+        " FROM generate_series(1, 3) n", 70.5);
+      int count{};
+      while ((r = conn->row())) {
+        const auto person = mapper.to<Person>(r);
+        ++count;
+        ASSERT(person.id == count);
+        ASSERT(person.name == "P" + std::to_string(count));
+        ASSERT(person.weight && *person.weight == 70.5);
+        conn->dismiss_response();
+        conn->wait_response();
+      }
+      conn->dismiss_response();
+
+      // The positions are resolved again when the names do not match.
+      conn->execute("SELECT 'Olga' name, 2 AS id, NULL::double precision AS weight");
+      r = conn->row();
+      ASSERT(r);
+      const auto person = mapper.to<Person>(r);
+      ASSERT(person.id == 2 && person.name == "Olga" && !person.weight);
+      conn->complete();
+
+      conn->execute("SELECT 1 AS id");
+      ASSERT(conn->row());
+      ASSERT(is_logic_throw_works([&]{ mapper.to_tuple(conn->row()); }));
+      conn->complete();
+
+      conn->set_row_processing(pgfe::Row_processing::batch);
+      conn->perform("SELECT n AS id, 'P' || n AS name, NULL::double precision AS weight"
+        " FROM generate_series(1, 3) n");
+      const auto* const rs = conn->row_set();
+      ASSERT(rs && rs->row_count() == 3);
+      for (std::size_t i = 0; i < rs->row_count(); ++i) {
+        const auto [id, name, weight] = mapper.to_tuple(rs, i);
+        ASSERT(id == int(i + 1) && name == "P" + std::to_string(i + 1) && !weight);
+      }
+      conn->complete();
+      conn->set_row_processing(pgfe::Row_processing::single);
+    }
+
+    // Binary records
+    {
+      conn->set_result_format(pgfe::Data_format::binary);
+      conn->execute("SELECT ROW(1, 'one'::text, NULL::integer, ROW(2::bigint))");
+      ASSERT(conn->row());
+      const auto record = pgfe::Record::make(conn->row()->data(0));
+      ASSERT(record->field_count() == 4);
+      ASSERT(record->type_oid(0) == 23);
+      const auto [one, text, null] = record->to_tuple<int, std::string, std::optional<int>>();
+      ASSERT(one == 1 && text == "one" && !null);
+      const auto nested = pgfe::Record::make(record->data(3));
+      ASSERT(nested->field_count() == 1 && pgfe::to<long long>(nested->data(0)) == 2);
+      conn->complete();
+      conn->set_result_format(pgfe::Data_format::text);
+
+      // The encoded record is accepted by the server.
+      const auto id = pgfe::to_data(3, pgfe::Data_format::binary);
+      const auto data = pgfe::to_record_data({{23, id.get()}, {25, nullptr}});
+      conn->perform("CREATE TYPE pg_temp.pgfe_test_pair AS (f1 integer, f2 text)");
+      auto* const ps = conn->prepare_statement("SELECT ($1::pg_temp.pgfe_test_pair).f1");
+      ps->set_parameter_no_copy(0, data.get());
+      ps->execute();
+      ASSERT(conn->row() && pgfe::to<int>(conn->row()->data(0)) == 3);
+      conn->complete();
+    }
   } catch (const std::exception& e) {
     report_failure(argv[0], e);
     return 1;
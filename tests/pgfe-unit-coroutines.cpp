@@ -0,0 +1,131 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "pgfe-unit.hpp"
+
+#include <dmitigr/pgfe/conversions.hpp>
+#include <dmitigr/pgfe/coroutines.hpp>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace pgfe = dmitigr::pgfe;
+
+namespace {
+
+pgfe::Task<int> answer()
+{
+  co_return 42;
+}
+
+pgfe::Task<int> twice(const int value)
+{
+  co_return 2 * co_await answer() + value - 42;
+}
+
+pgfe::Task<int> fail()
+{
+  throw std::runtime_error{"fail"};
+  co_return 0;
+}
+
+pgfe::Task<> sum(const int count, int& result)
+{
+  for (int i = 0; i < count; ++i)
+    result += co_await twice(i);
+}
+
+pgfe::Task<> select_series(pgfe::Async_connection<>& conn, const int count, int& result)
+{
+  co_await conn.connect();
+  co_await conn.execute("SELECT i FROM generate_series(1, $1) i, pg_sleep(0.5)", count);
+  while (const auto row = co_await conn.next_row())
+    result += pgfe::to<int>(row->data(0));
+  conn.connection()->dismiss_response(); // the completion
+}
+
+} // namespace
+
+int main(int, char* argv[])
+{
+  using namespace dmitigr::test;
+
+  try {
+    // Composition of tasks
+    {
+      int result{};
+      pgfe::spawn(sum(3, result));
+      ASSERT(result == 42 + 43 + 44);
+    }
+
+    // Propagation of exceptions
+    {
+      bool is_thrown{};
+      pgfe::spawn([]() -> pgfe::Task<> { co_await fail(); }(),
+        [&is_thrown](const std::exception_ptr e)
+        {
+          try {
+            std::rethrow_exception(e);
+          } catch (const std::runtime_error&) {
+            is_thrown = true;
+          }
+        });
+      ASSERT(is_thrown);
+    }
+
+    const auto reactor = pgfe::Reactor::make();
+    ASSERT(is_logic_throw_works([&]{ pgfe::Async_connection<>{*reactor, nullptr}; }));
+
+    // Connection failure
+    {
+      const auto conn_opts = pgfe::test::connection_options();
+      conn_opts->set_port(1); // nobody should listen there
+      const auto conn = pgfe::Connection::make(conn_opts.get());
+      reactor->add(conn.get());
+      pgfe::Async_connection<> async_conn{*reactor, conn.get()};
+      bool is_thrown{};
+      pgfe::spawn([](pgfe::Async_connection<>& conn) -> pgfe::Task<> { co_await conn.connect(); }(async_conn),
+        [&is_thrown](const std::exception_ptr) { is_thrown = true; });
+      ASSERT(!is_thrown);
+      reactor->run();
+      ASSERT(is_thrown);
+      ASSERT(conn->communication_status() == pgfe::Communication_status::failure);
+      reactor->remove(conn.get());
+    }
+
+    // Many concurrent queries
+    {
+      constexpr int connection_count = 8;
+      std::vector<std::unique_ptr<pgfe::Connection>> connections;
+      std::vector<pgfe::Async_connection<>> async_connections;
+      std::vector<int> results(connection_count);
+      for (int i = 0; i < connection_count; ++i) {
+        connections.push_back(pgfe::test::make_connection());
+        reactor->add(connections.back().get());
+        async_connections.emplace_back(*reactor, connections.back().get());
+      }
+      std::exception_ptr error;
+      for (int i = 0; i < connection_count; ++i)
+        pgfe::spawn(select_series(async_connections[i], i + 1, results[i]),
+          [&error](const std::exception_ptr e) { error = e; });
+
+      const auto started = std::chrono::steady_clock::now();
+      reactor->run();
+      if (error)
+        std::rethrow_exception(error);
+      const auto elapsed = std::chrono::steady_clock::now() - started;
+      ASSERT(elapsed < std::chrono::milliseconds{500 * connection_count / 2});
+      for (int i = 0; i < connection_count; ++i)
+        ASSERT(results[i] == (i + 1) * (i + 2) / 2);
+    }
+  } catch (const std::exception& e) {
+    report_failure(argv[0], e);
+    return 1;
+  } catch (...) {
+    report_failure(argv[0]);
+    return 1;
+  }
+}
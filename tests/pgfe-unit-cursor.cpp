@@ -0,0 +1,109 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "pgfe-unit.hpp"
+
+#include <dmitigr/pgfe/basics.hpp>
+#include <dmitigr/pgfe/conversions.hpp>
+#include <dmitigr/pgfe/cursor.hpp>
+#include <dmitigr/pgfe/exceptions.hpp>
+#include <dmitigr/pgfe/row_set.hpp>
+
+int main(int, char* argv[])
+{
+  namespace pgfe = dmitigr::pgfe;
+  using namespace dmitigr::test;
+
+  try {
+    ASSERT(is_logic_throw_works([]{ pgfe::Cursor::make(nullptr, "SELECT 1"); }));
+
+    const auto conn = pgfe::test::make_connection();
+    ASSERT(is_logic_throw_works([&]{ pgfe::Cursor::make(conn.get(), "SELECT 1"); }));
+    conn->connect();
+    ASSERT(is_logic_throw_works([&]{ pgfe::Cursor::make(conn.get(), ""); }));
+    ASSERT(is_logic_throw_works([&]{ pgfe::Cursor::make(conn.get(), "SELECT 1", 0); }));
+
+    // The cursor with its own transaction block.
+    {
+      const auto cursor = pgfe::Cursor::make(conn.get(), "SELECT generate_series(1, 25)", 10);
+      ASSERT(cursor->is_open());
+      ASSERT(cursor->connection() == conn.get());
+      ASSERT(!cursor->name().empty());
+      ASSERT(cursor->batch_size() == 10);
+      ASSERT(conn->is_transaction_block_uncommitted());
+      ASSERT(conn->row_processing() == pgfe::Row_processing::single);
+
+      int expected{1};
+      std::size_t batch_count{};
+      while (const auto* const rows = cursor->fetch()) {
+        ++batch_count;
+        for (std::size_t i = 0; i < rows->row_count(); ++i)
+          ASSERT(pgfe::to<int>(rows->data(i, 0)) == expected++);
+        if (batch_count == 1)
+          cursor->set_batch_size(5); // applied to the batch after the next one
+      }
+      ASSERT(expected == 26);
+      ASSERT(batch_count == 3); // 10 + 10 + 5
+      ASSERT(!cursor->fetch());
+
+      cursor->close();
+      ASSERT(!cursor->is_open());
+      ASSERT(!conn->is_transaction_block_uncommitted());
+      ASSERT(is_logic_throw_works([&]{ cursor->fetch(); }));
+    }
+
+    // The cursor in the transaction block of the caller.
+    {
+      conn->perform("BEGIN");
+      {
+        const auto cursor = pgfe::Cursor::make(conn.get(), "SELECT 1 WHERE false");
+        ASSERT(!cursor->fetch());
+        cursor->close();
+      }
+      ASSERT(conn->is_transaction_block_uncommitted());
+      conn->perform("COMMIT");
+    }
+
+    // The cursor is closed upon the destruction.
+    {
+      {
+        const auto cursor = pgfe::Cursor::make(conn.get(), "SELECT generate_series(1, 100)", 10);
+        ASSERT(cursor->fetch());
+      }
+      ASSERT(conn->is_ready_for_request());
+      ASSERT(!conn->is_transaction_block_uncommitted());
+    }
+
+    // Errors.
+    {
+      ASSERT(is_runtime_throw_works([&]{ pgfe::Cursor::make(conn.get(), "SELECT * FROM nonexistent_table"); }));
+      ASSERT(conn->is_ready_for_request());
+      ASSERT(!conn->is_transaction_block_uncommitted());
+
+      const auto cursor = pgfe::Cursor::make(conn.get(), "SELECT 1 / (3 - generate_series(1, 5))", 1);
+      ASSERT(cursor->fetch());
+      ASSERT(cursor->fetch());
+      bool is_thrown{};
+      try {
+        cursor->fetch();
+      } catch (const pgfe::Server_exception& e) {
+        ASSERT(e.code() == pgfe::Server_errc::c22_division_by_zero);
+        is_thrown = true;
+      }
+      ASSERT(is_thrown);
+      ASSERT(!cursor->fetch());
+      cursor->close();
+      ASSERT(conn->is_ready_for_request());
+      ASSERT(!conn->is_transaction_block_uncommitted());
+    }
+  } catch (const std::exception& e) {
+    report_failure(argv[0], e);
+    return 1;
+  } catch (...) {
+    report_failure(argv[0]);
+    return 1;
+  }
+
+  return 0;
+}
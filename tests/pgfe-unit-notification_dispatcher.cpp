@@ -0,0 +1,102 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "pgfe-unit.hpp"
+
+#include <dmitigr/pgfe/conversions.hpp>
+#include <dmitigr/pgfe/notification.hpp>
+#include <dmitigr/pgfe/notification_dispatcher.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+int main(int, char* argv[])
+{
+  namespace pgfe = dmitigr::pgfe;
+  using namespace dmitigr::test;
+  using namespace std::chrono_literals;
+
+  try {
+    ASSERT(is_logic_throw_works([]{ pgfe::Notification_dispatcher::make(nullptr); }));
+
+    const auto dispatcher = pgfe::Notification_dispatcher::make(pgfe::test::make_connection());
+    ASSERT(dispatcher->connection());
+    ASSERT(!dispatcher->connection()->is_connected());
+    ASSERT(dispatcher->subscription_count() == 0);
+
+    std::vector<std::string> received1;
+    std::vector<std::string> received2;
+    std::size_t batch_count1{};
+    const auto subscriber = [](std::vector<std::string>& received, std::size_t* const batch_count = nullptr)
+    {
+      return [&received, batch_count](const std::vector<std::unique_ptr<pgfe::Notification>>& notifications)
+      {
+        ASSERT(!notifications.empty());
+        if (batch_count)
+          ++*batch_count;
+        for (const auto& n : notifications)
+          received.push_back(pgfe::to<std::string>(n->payload()));
+      };
+    };
+    ASSERT(is_logic_throw_works([&]{ dispatcher->subscribe("", subscriber(received1)); }));
+    ASSERT(is_logic_throw_works([&]{ dispatcher->subscribe("pgfe_test_channel1", {}); }));
+    dispatcher->subscribe("pgfe_test_channel1", subscriber(received1, &batch_count1));
+    dispatcher->subscribe("pgfe_test_channel2", subscriber(received2));
+    ASSERT(dispatcher->subscription_count() == 2);
+    ASSERT(dispatcher->has_subscription("pgfe_test_channel1"));
+    ASSERT(!dispatcher->has_subscription("pgfe_test_channel3"));
+
+    // The first dispatching connects and listens.
+    ASSERT(dispatcher->dispatch(0ms) == 0);
+    ASSERT(dispatcher->connection()->is_connected());
+
+    const auto notifier = pgfe::test::make_connection();
+    notifier->connect();
+
+    const auto dispatch = [&dispatcher](const std::size_t expected_count)
+    {
+      std::size_t count{};
+      for (int i = 0; i < 50 && count < expected_count; ++i)
+        count += dispatcher->dispatch(100ms);
+      return count;
+    };
+
+    // Burst of notifications.
+    notifier->perform("BEGIN");
+    notifier->perform("NOTIFY pgfe_test_channel1, 'a'");
+    notifier->perform("NOTIFY pgfe_test_channel2, 'b'");
+    notifier->perform("NOTIFY pgfe_test_channel1, 'c'");
+    notifier->perform("COMMIT");
+    ASSERT(dispatch(3) == 3);
+    ASSERT((received1 == std::vector<std::string>{"a", "c"}));
+    ASSERT((received2 == std::vector<std::string>{"b"}));
+    ASSERT(batch_count1 == 1);
+
+    // Unsubscription.
+    dispatcher->unsubscribe("pgfe_test_channel2");
+    ASSERT(!dispatcher->has_subscription("pgfe_test_channel2"));
+    notifier->perform("NOTIFY pgfe_test_channel2, 'd'");
+    notifier->perform("NOTIFY pgfe_test_channel1, 'e'");
+    ASSERT(dispatch(1) == 1);
+    ASSERT(received1.back() == "e");
+    ASSERT(received2.size() == 1);
+
+    // Reconnection.
+    dispatcher->connection()->disconnect();
+    ASSERT(dispatcher->dispatch(0ms) == 0);
+    ASSERT(dispatcher->connection()->is_connected());
+    notifier->perform("NOTIFY pgfe_test_channel1, 'f'");
+    ASSERT(dispatch(1) == 1);
+    ASSERT(received1.back() == "f");
+  } catch (const std::exception& e) {
+    report_failure(argv[0], e);
+    return 1;
+  } catch (...) {
+    report_failure(argv[0]);
+    return 1;
+  }
+
+  return 0;
+}
@@ -4,13 +4,19 @@
 
 #include "pgfe-unit.hpp"
 
+#include <dmitigr/pgfe/completion.hpp>
 #include <dmitigr/pgfe/conversions.hpp>
+#include <dmitigr/pgfe/error.hpp>
 #include <dmitigr/pgfe/exceptions.hpp>
 #include <dmitigr/pgfe/prepared_statement_dfn.hpp>
 #include <dmitigr/pgfe/row.hpp>
 #include <dmitigr/pgfe/row_info.hpp>
 #include <dmitigr/pgfe/sql_string.hpp>
 
+#include <string>
+#include <tuple>
+#include <vector>
+
 int main(int, char* argv[])
 {
   namespace pgfe = dmitigr::pgfe;
@@ -147,6 +153,151 @@ int main(int, char* argv[])
       conn->wait_response();
       ++i;
     }
+    conn->dismiss_response();
+
+    // Batch execution
+    {
+      conn->perform("CREATE TEMP TABLE batch_test(id integer PRIMARY KEY, name text)");
+      auto* const ps = conn->prepare_statement("INSERT INTO batch_test VALUES ($1, $2)", "batch");
+
+      std::vector<std::tuple<int, std::string>> rows;
+      for (int id = 1; id <= 100; ++id)
+        rows.emplace_back(id, "name" + std::to_string(id));
+      const auto completion = ps->execute_batch(rows);
+      ASSERT(completion);
+      ASSERT(completion->operation_name() == "INSERT");
+      ASSERT(completion->affected_row_count() == "100");
+      ASSERT(!conn->is_pipeline_enabled());
+      ASSERT(conn->is_ready_for_request());
+
+      // The duplicate key of the third set of parameters.
+      rows = {{101, "a"}, {102, "b"}, {1, "c"}, {103, "d"}};
+      std::size_t error_index{};
+      std::size_t error_count{};
+      ASSERT(!ps->execute_batch(rows, [&](const std::size_t index, std::unique_ptr<pgfe::Error>&& error)
+      {
+        ASSERT(error && error->code() == pgfe::Server_errc::c23_unique_violation);
+        error_index = index;
+        ++error_count;
+      }));
+      ASSERT(error_count == 1 && error_index == 2);
+      ASSERT(is_runtime_throw_works([&]{ ps->execute_batch(rows); }));
+
+      // The executions are rolled back.
+      conn->execute("SELECT count(*) FROM batch_test");
+      ASSERT(conn->row() && pgfe::to<int>(conn->row()->data(0)) == 100);
+      conn->complete();
+
+      // The rows produced by the executions are dismissed.
+      auto* const del = conn->prepare_statement("DELETE FROM batch_test WHERE id = $1 RETURNING id");
+      const std::vector<int> ids{1, 2, 3};
+      const auto deleted = del->execute_batch(ids);
+      ASSERT(deleted && deleted->operation_name() == "DELETE" && deleted->affected_row_count() == "3");
+
+      int id{};
+      const auto inserted = ps->execute_batch([&]
+      {
+        if (++id > 3)
+          return false;
+        ps->set_parameters(id, "again");
+        return true;
+      });
+      ASSERT(inserted && inserted->affected_row_count() == "3");
+      ASSERT(!ps->execute_batch(std::vector<int>{}));
+
+      // The executions are rolled back if the binding throws.
+      id = 200;
+      ASSERT(is_runtime_throw_works([&]
+      {
+        ps->execute_batch([&]
+        {
+          if (++id > 203)
+            throw std::runtime_error{"binding failed"};
+          ps->set_parameters(id, "aborted");
+          return true;
+        });
+      }));
+      ASSERT(!conn->is_pipeline_enabled() && conn->is_ready_for_request());
+      conn->execute("SELECT count(*) FROM batch_test WHERE id > 200");
+      ASSERT(conn->row() && pgfe::to<int>(conn->row()->data(0)) == 0);
+      conn->complete();
+
+      // The original exception is rethrown if the connection is broken upon the batch.
+      {
+        const auto victim = pgfe::test::make_connection();
+        victim->connect();
+        auto* const victim_ps = victim->prepare_statement("SELECT $1::integer");
+        int n{};
+        std::string what;
+        try {
+          victim_ps->execute_batch([&]
+          {
+            if (++n > 3) {
+              conn->execute("SELECT pg_terminate_backend($1)", *victim->server_pid());
+              conn->complete();
+              throw std::runtime_error{"binding failed"};
+            }
+            victim_ps->set_parameter(0, n);
+            return true;
+          });
+        } catch (const std::exception& e) {
+          what = e.what();
+        }
+        ASSERT(what == "binding failed");
+      }
+
+      // The responses are collected while submitting the large batch.
+      auto* const series = conn->prepare_statement("SELECT generate_series(1, $1::integer)");
+      const std::vector<int> sizes(2000, 100);
+      const auto selected = series->execute_batch(sizes);
+      ASSERT(selected && selected->affected_row_count() == std::to_string(2000 * 100));
+    }
+
+    // Inline storage of the parameters
+    {
+      auto* const ps = conn->prepare_statement("SELECT $1::integer, $2::text, $3::bigint");
+      ps->set_parameters(-12345, std::string("short"), 9000000000LL);
+      ASSERT(ps->parameter(0) && std::string(ps->parameter(0)->bytes()) == "-12345");
+      ASSERT(ps->parameter(1) && std::string(ps->parameter(1)->bytes()) == "short");
+      ASSERT(ps->parameter(2) && std::string(ps->parameter(2)->bytes()) == "9000000000");
+      ps->execute();
+      ASSERT(conn->row());
+      ASSERT(pgfe::to<int>(conn->row()->data(0)) == -12345);
+      ASSERT(pgfe::to<std::string>(conn->row()->data(1)) == "short");
+      ASSERT(pgfe::to<long long>(conn->row()->data(2)) == 9000000000LL);
+      conn->complete();
+
+      // The strings which don't fit into the inline storage.
+      const std::string long_text(pgfe::Prepared_statement::inline_parameter_size + 1, 'x');
+      ps->set_parameter(1, long_text);
+      ASSERT(ps->parameter(1)->size() == long_text.size());
+      ASSERT(ps->parameter(1)->bytes() == long_text);
+      ps->set_parameter_copy(1, "copied");
+      ASSERT(ps->parameter(1)->bytes() == std::string{"copied"});
+      ps->set_parameter(1, nullptr);
+      ASSERT(!ps->parameter(1));
+      ASSERT(is_logic_throw_works([&]{ ps->set_parameter_copy(3, "out of range"); }));
+
+      // The binary format.
+      ps->set_parameter_format(pgfe::Data_format::binary);
+      ps->set_parameter(0, 258);
+      ASSERT(ps->parameter(0)->format() == pgfe::Data_format::binary);
+      ASSERT(ps->parameter(0)->size() == 4);
+      ASSERT(pgfe::to<int>(ps->parameter(0)) == 258);
+      ps->set_parameter(2, -2LL);
+      ps->execute();
+      ASSERT(conn->row());
+      ASSERT(pgfe::to<int>(conn->row()->data(0)) == 258);
+      ASSERT(pgfe::to<long long>(conn->row()->data(2)) == -2);
+      conn->complete();
+
+      // The binding of the other parameters doesn't invalidate the parameter.
+      auto* const unparsed = conn->prepare_statement(std::string{"SELECT $1::integer, $2::integer"});
+      unparsed->set_parameter(0, 1);
+      const auto* const first = unparsed->parameter(0);
+      unparsed->set_parameter(1, 2);
+      ASSERT(unparsed->parameter(0) == first && pgfe::to<int>(first) == 1);
+    }
   } catch (const std::exception& e) {
     report_failure(argv[0], e);
     return 1;
@@ -0,0 +1,113 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "pgfe-unit.hpp"
+
+#include <dmitigr/pgfe/conversions.hpp>
+#include <dmitigr/pgfe/reactor.hpp>
+#include <dmitigr/pgfe/row.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+int main(int, char* argv[])
+{
+  namespace pgfe = dmitigr::pgfe;
+  using namespace dmitigr::test;
+  using namespace std::chrono_literals;
+
+  try {
+    const auto reactor = pgfe::Reactor::make();
+    ASSERT(reactor);
+    ASSERT(reactor->size() == 0);
+    ASSERT(reactor->pending_count() == 0);
+    ASSERT(reactor->run_once(0ms) == 0);
+    ASSERT(is_logic_throw_works([&]{ reactor->add(nullptr); }));
+
+    // Registration
+    {
+      const auto conn = pgfe::test::make_connection();
+      reactor->add(conn.get());
+      ASSERT(reactor->has(conn.get()));
+      ASSERT(reactor->size() == 1);
+      ASSERT(!reactor->is_pending(conn.get()));
+      ASSERT(is_logic_throw_works([&]{ reactor->add(conn.get()); }));
+      ASSERT(is_logic_throw_works([&]{ reactor->await_response(conn.get(), {}); }));
+      reactor->remove(conn.get());
+      ASSERT(!reactor->has(conn.get()));
+      ASSERT(reactor->size() == 0);
+    }
+
+    // Connection failure
+    {
+      const auto conn_opts = pgfe::test::connection_options();
+      conn_opts->set_port(1); // nobody should listen there
+      const auto conn = pgfe::Connection::make(conn_opts.get());
+      reactor->add(conn.get());
+      bool is_handled{};
+      reactor->connect(conn.get(), [&is_handled](pgfe::Connection* const conn)
+      {
+        ASSERT(conn->communication_status() == pgfe::Communication_status::failure);
+        is_handled = true;
+      });
+      reactor->run();
+      ASSERT(is_handled);
+      ASSERT(reactor->pending_count() == 0);
+      ASSERT(!reactor->is_pending(conn.get()));
+      reactor->remove(conn.get());
+    }
+
+    // Many concurrent queries
+    {
+      constexpr int connection_count = 8;
+      std::vector<std::unique_ptr<pgfe::Connection>> connections;
+      std::vector<int> results(connection_count, -1);
+      for (int i = 0; i < connection_count; ++i) {
+        connections.push_back(pgfe::test::make_connection());
+        auto* const conn = connections.back().get();
+        reactor->add(conn);
+
+        // Each row and the completion are awaited separately.
+        std::shared_ptr<pgfe::Reactor::Handler> on_response = std::make_shared<pgfe::Reactor::Handler>();
+        *on_response = [&reactor, &results, i, on_response](pgfe::Connection* const conn)
+        {
+          ASSERT(!conn->error());
+          if (conn->row())
+            results[i] = pgfe::to<int>(conn->row()->data(0));
+          conn->dismiss_response();
+          if (conn->is_awaiting_response())
+            reactor->await_response(conn, *on_response);
+          else
+            *on_response = {}; // break the reference cycle
+        };
+
+        reactor->connect(conn, [&reactor, i, on_response](pgfe::Connection* const conn)
+        {
+          ASSERT(conn->is_connected());
+          conn->perform_async("SELECT " + std::to_string(i) + " FROM pg_sleep(0.5)");
+          reactor->await_response(conn, *on_response);
+        });
+      }
+      ASSERT(reactor->pending_count() == connection_count);
+
+      const auto started = std::chrono::steady_clock::now();
+      reactor->run();
+      ASSERT(std::chrono::steady_clock::now() - started < 0.5s * connection_count);
+      ASSERT(reactor->pending_count() == 0);
+      for (int i = 0; i < connection_count; ++i) {
+        ASSERT(results[i] == i);
+        ASSERT(connections[i]->is_ready_for_request());
+        reactor->remove(connections[i].get());
+      }
+      ASSERT(reactor->size() == 0);
+    }
+  } catch (const std::exception& e) {
+    report_failure(argv[0], e);
+    return 1;
+  } catch (...) {
+    report_failure(argv[0]);
+    return 1;
+  }
+}
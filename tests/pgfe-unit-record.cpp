@@ -0,0 +1,108 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or pgfe.hpp
+
+#include "unit.hpp"
+
+#include <dmitigr/pgfe/composite.hpp>
+#include <dmitigr/pgfe/conversions.hpp>
+#include <dmitigr/pgfe/data.hpp>
+#include <dmitigr/pgfe/record.hpp>
+
+#include <optional>
+#include <string>
+
+int main(int, char* argv[])
+{
+  namespace pgfe = dmitigr::pgfe;
+  using namespace dmitigr::test;
+
+  try {
+    constexpr std::uint_fast32_t int4_oid{23};
+    constexpr std::uint_fast32_t text_oid{25};
+    constexpr std::uint_fast32_t record_oid{2249};
+
+    // Encoding and decoding.
+    const auto id = pgfe::to_data(-7, pgfe::Data_format::binary);
+    const auto name = pgfe::Data::make("Dmitry", pgfe::Data_format::binary);
+    const auto empty = pgfe::Data::make(std::string{}, pgfe::Data_format::binary);
+    const auto nested = pgfe::to_record_data({{int4_oid, id.get()}});
+    const auto data = pgfe::to_record_data({{int4_oid, id.get()}, {text_oid, name.get()},
+      {text_oid, nullptr}, {text_oid, empty.get()}, {record_oid, nested.get()}});
+    ASSERT(data->format() == pgfe::Data_format::binary);
+    ASSERT(data->size() == 4 + (8 + 4) + (8 + 6) + 8 + 8 + (8 + nested->size()));
+
+    const auto record = pgfe::Record::make(data.get());
+    ASSERT(record->field_count() == 5);
+    ASSERT(record->type_oid(0) == int4_oid);
+    ASSERT(record->type_oid(1) == text_oid);
+    ASSERT(record->type_oid(4) == record_oid);
+    ASSERT(record->data(0) && pgfe::to<int>(record->data(0)) == -7);
+    ASSERT(record->data(1) && record->data(1)->format() == pgfe::Data_format::binary);
+    ASSERT(pgfe::to<std::string>(record->data(1)) == "Dmitry");
+    ASSERT(record->data(1)->bytes() > data->bytes() &&
+      record->data(1)->bytes() < data->bytes() + data->size()); // the view
+    ASSERT(!record->data(2));
+    ASSERT(record->data(3) && record->data(3)->size() == 0);
+    ASSERT(is_logic_throw_works([&]{ record->data(5); }));
+    ASSERT(is_logic_throw_works([&]{ record->type_oid(5); }));
+
+    // Nested record.
+    const auto nested_record = pgfe::Record::make(record->data(4));
+    ASSERT(nested_record->field_count() == 1);
+    ASSERT(pgfe::to<int>(nested_record->data(0)) == -7);
+
+    // Mapping.
+    {
+      const auto [i, s, n] = record->to_tuple<int, std::string, std::optional<std::string>>();
+      ASSERT(i == -7 && s == "Dmitry" && !n);
+
+      struct Person final {
+        int id;
+        std::string name;
+      };
+      const auto person = record->to<Person, int, std::string>();
+      ASSERT(person.id == -7 && person.name == "Dmitry");
+      ASSERT(is_runtime_throw_works([&]{ record->to_tuple<int, std::string, std::string>(); }));
+    }
+
+    // Composite.
+    {
+      const auto composite = record->to_composite();
+      ASSERT(composite->field_count() == 5);
+      ASSERT(composite->field_name(0).empty());
+      ASSERT(!composite->data(2));
+      ASSERT(pgfe::to<std::string>(composite->data(1)) == "Dmitry");
+
+      const auto named = nested_record->to_composite({"id"});
+      ASSERT(named->field_name(0) == "id");
+      ASSERT(pgfe::to<int>(named->data("id")) == -7);
+      ASSERT(is_logic_throw_works([&]{ record->to_composite({"id"}); }));
+    }
+
+    // Empty record.
+    {
+      const auto empty_data = pgfe::to_record_data({});
+      ASSERT(empty_data->size() == 4);
+      ASSERT(pgfe::Record::make(empty_data.get())->field_count() == 0);
+    }
+
+    // Malformed records.
+    {
+      ASSERT(is_logic_throw_works([]{ pgfe::Record::make(nullptr); }));
+      ASSERT(is_logic_throw_works([&]{ pgfe::Record::make(pgfe::Data::make("text").get()); }));
+      const auto truncated = pgfe::Data::make(data->bytes(), data->size() - 1, pgfe::Data_format::binary);
+      ASSERT(is_runtime_throw_works([&]{ pgfe::Record::make(truncated.get()); }));
+      const auto short_data = pgfe::Data::make(data->bytes(), 3, pgfe::Data_format::binary);
+      ASSERT(is_runtime_throw_works([&]{ pgfe::Record::make(short_data.get()); }));
+    }
+  } catch (const std::exception& e) {
+    report_failure(argv[0], e);
+    return 1;
+  } catch (...) {
+    report_failure(argv[0]);
+    return 1;
+  }
+
+  return 0;
+}
@@ -8,6 +8,43 @@
 #include <dmitigr/pgfe/exceptions.hpp>
 #include <dmitigr/pgfe/sql_string.hpp>
 
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+/// The total size of the memory allocated by the operator new.
+std::size_t allocated_size;
+
+/// The size of the header of the allocated memory where its size is stored.
+constexpr std::size_t allocation_header_size{alignof(std::max_align_t)};
+
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+  if (auto* const result = static_cast<char*>(std::malloc(allocation_header_size + size))) {
+    *reinterpret_cast<std::size_t*>(result) = size;
+    allocated_size += size;
+    return result + allocation_header_size;
+  } else
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* const ptr) noexcept
+{
+  if (ptr) {
+    auto* const allocation = static_cast<char*>(ptr) - allocation_header_size;
+    allocated_size -= *reinterpret_cast<const std::size_t*>(allocation);
+    std::free(allocation);
+  }
+}
+
+void operator delete(void* const ptr, std::size_t) noexcept
+{
+  operator delete(ptr);
+}
+
 int main(int, char* argv[])
 {
   namespace pgfe = dmitigr::pgfe;
@@ -101,6 +138,77 @@ int main(int, char* argv[])
 
       std::cout << "Final SQL string is: " << s_orig->to_string() << std::endl;
     }
+
+    // Quoted literals and identifiers are preserved as is
+    {
+      const std::string query{"SELECT 'Dianne''s horse', \"a\"\"b\", $tag$:not_param$tag$, :p"};
+      auto s = pgfe::Sql_string::make(query + "; SELECT 2");
+      ASSERT(s->to_string() == query);
+      ASSERT(s->to_query_string() == "SELECT 'Dianne''s horse', \"a\"\"b\", $tag$:not_param$tag$, $1");
+      ASSERT(s->named_parameter_count() == 1);
+      ASSERT(s->parameter_name(0) == "p");
+
+      s->replace_parameter("p", ":q || 'x''y'");
+      s->append(" -- comment\r\n");
+      ASSERT(s->to_string() == "SELECT 'Dianne''s horse', \"a\"\"b\", $tag$:not_param$tag$, :q || 'x''y' -- comment\n");
+      ASSERT(s->parameter_name(0) == "q");
+    }
+
+    // Rendering of the query string after modifications
+    {
+      auto s = pgfe::Sql_string::make("SELECT :a, :b, :c, :b");
+      ASSERT(s->to_query_string() == "SELECT $1, $2, $3, $2");
+      ASSERT(s->to_query_string() == "SELECT $1, $2, $3, $2");
+
+      s->replace_parameter("b", ":c + :d + :a");
+      ASSERT(s->parameter_count() == 3);
+      ASSERT(s->parameter_name(0) == "a");
+      ASSERT(s->parameter_name(1) == "c");
+      ASSERT(s->parameter_name(2) == "d");
+      ASSERT(s->to_query_string() == "SELECT $1, $2 + $3 + $1, $2, $2 + $3 + $1");
+
+      s->append(", :e, :a");
+      ASSERT(s->parameter_index("e") == 3);
+      ASSERT(s->to_query_string() == "SELECT $1, $2 + $3 + $1, $2, $2 + $3 + $1, $4, $1");
+
+      const auto copy = s->to_sql_string();
+      s->replace_parameter("a", "1");
+      ASSERT(s->to_query_string() == "SELECT 1, $1 + $2 + 1, $1, $1 + $2 + 1, $3, 1");
+      ASSERT(copy->to_query_string() == "SELECT $1, $2 + $3 + $1, $2, $2 + $3 + $1, $4, $1");
+    }
+
+    // Replacing with the single fragment and with nothing
+    {
+      auto s = pgfe::Sql_string::make("SELECT :a, :b, :c, :b");
+      s->replace_parameter("b", ":c");
+      ASSERT(s->parameter_count() == 2);
+      ASSERT(s->parameter_index("c") == 1);
+      ASSERT(s->to_query_string() == "SELECT $1, $2, $2, $2");
+      s->replace_parameter("a", ":d");
+      ASSERT(s->parameter_name(0) == "d");
+      ASSERT(s->to_string() == "SELECT :d, :c, :c, :c");
+      s->replace_parameter("c", "");
+      ASSERT(s->parameter_count() == 1);
+      ASSERT(s->to_query_string() == "SELECT $1, , , ");
+    }
+
+    // The text of the replaced parameters is released
+    {
+      auto s = pgfe::Sql_string::make("SELECT :a FROM pgfe_table_with_quite_a_long_name");
+      const auto replace = [&s](const int count)
+      {
+        for (int i = 0; i < count; ++i) {
+          s->replace_parameter("a", ":b");
+          s->replace_parameter("b", ":a");
+        }
+      };
+      replace(100);
+      const auto size = allocated_size;
+      replace(10000);
+      ASSERT(allocated_size < size + 1024);
+      ASSERT(s->to_string() == "SELECT :a FROM pgfe_table_with_quite_a_long_name");
+      ASSERT(s->to_query_string() == "SELECT $1 FROM pgfe_table_with_quite_a_long_name");
+    }
   } catch (const std::exception& e) {
     report_failure(argv[0], e);
     return 1;
@@ -73,6 +73,45 @@ int main(int, char* argv[])
     const auto* const plus_one = bunch->sql_string("id", "plus_one");
     ASSERT(plus_one);
 
+    // -------------------------------------------------------------------------
+    // Indexed lookup test
+    // -------------------------------------------------------------------------
+
+    {
+      auto indexed = bunch->to_sql_vector();
+      ASSERT(!indexed->indexed_extra_name());
+      indexed->set_indexed_extra_name("id");
+      ASSERT(indexed->indexed_extra_name() == "id");
+      ASSERT(indexed->sql_string_index("id", "plus_one") == 0);
+      ASSERT(indexed->sql_string_index("id", "digit") == 1);
+      ASSERT(!indexed->sql_string_index("id", "digit", 2));
+      ASSERT(!indexed->has_sql_string("id", "unknown"));
+
+      indexed->insert_sql_string(0, "-- $id$first$id$\nSELECT 0");
+      ASSERT(indexed->sql_string_index("id", "first") == 0);
+      ASSERT(indexed->sql_string_index("id", "plus_one") == 1);
+      ASSERT(indexed->sql_string_index("id", "digit") == 2);
+
+      indexed->append_sql_string("-- $id$digit$id$\nSELECT 9");
+      ASSERT(indexed->sql_string_index("id", "digit") == 2);
+      ASSERT(indexed->sql_string_index("id", "digit", 3) == 3);
+
+      indexed->remove_sql_string(2);
+      ASSERT(indexed->sql_string_index("id", "digit") == 2);
+      ASSERT(indexed->sql_string(2)->to_query_string() == "SELECT 9");
+
+      indexed->set_sql_string(1, "-- $id$last$id$\nSELECT 1");
+      ASSERT(!indexed->has_sql_string("id", "plus_one"));
+      ASSERT(indexed->sql_string_index("id", "last") == 1);
+
+      // The copy is indexed too.
+      ASSERT(indexed->to_sql_vector()->sql_string_index("id", "last") == 1);
+
+      indexed->set_indexed_extra_name(std::nullopt);
+      ASSERT(!indexed->indexed_extra_name());
+      ASSERT(indexed->sql_string_index("id", "last") == 1);
+    }
+
     const auto conn = pgfe::test::make_connection();
     conn->connect();
 
@@ -0,0 +1,72 @@
+// -*- C++ -*-
+// Copyright (C) Dmitry Igrishin
+// For conditions of distribution and use, see files LICENSE.txt or util.hpp
+
+#include "unit.hpp"
+
+#include <dmitigr/util.hpp>
+
+#include <thread>
+#include <vector>
+
+int main(int, char* argv[])
+{
+  namespace memory = dmitigr::memory;
+  using namespace dmitigr::test;
+
+  try {
+    using Pool = memory::Block_pool<64, 4>;
+
+    // The deallocated blocks are reused in the LIFO order.
+    {
+      void* const b1 = Pool::allocate();
+      void* const b2 = Pool::allocate();
+      ASSERT(b1 && b2 && b1 != b2);
+      Pool::deallocate(b1);
+      Pool::deallocate(b2);
+      ASSERT(Pool::allocate() == b2);
+      ASSERT(Pool::allocate() == b1);
+      Pool::deallocate(b1);
+      Pool::deallocate(b2);
+      Pool::deallocate(nullptr);
+    }
+
+    // The number of the retained blocks is limited by the capacity.
+    {
+      std::vector<void*> blocks;
+      for (int i = 0; i < 8; ++i)
+        blocks.push_back(Pool::allocate());
+      for (auto* const b : blocks)
+        Pool::deallocate(b);
+
+      // Only the first 4 of the deallocated blocks are retained (and they are
+      // reused in the LIFO order), the rest are released.
+      std::vector<void*> reused;
+      for (int i = 0; i < 4; ++i)
+        reused.push_back(Pool::allocate());
+      ASSERT((reused == std::vector<void*>{blocks[3], blocks[2], blocks[1], blocks[0]}));
+      for (auto* const b : reused)
+        Pool::deallocate(b);
+    }
+
+    // The blocks can be deallocated by another thread.
+    {
+      void* const b = Pool::allocate();
+      bool is_reused{};
+      std::thread t{[b, &is_reused]
+      {
+        Pool::deallocate(b);
+        is_reused = (Pool::allocate() == b);
+        Pool::deallocate(b);
+      }};
+      t.join();
+      ASSERT(is_reused);
+    }
+  } catch (const std::exception& e) {
+    report_failure(argv[0], e);
+    return 1;
+  } catch (...) {
+    report_failure(argv[0]);
+    return 1;
+  }
+}
@@ -6,6 +6,15 @@
 
 #include <dmitigr/util.hpp>
 
+#ifndef _WIN32
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 int main(int, char* argv[])
 {
   namespace net = dmitigr::net;
@@ -28,6 +37,45 @@ int main(int, char* argv[])
     ASSERT(ip->family() == net::Ip_version::v6);
     ASSERT(ip->binary());
     ASSERT(ip->to_string() == v6_addr_str);
+
+#ifndef _WIN32
+    // Polling of the descriptors which are greater than FD_SETSIZE
+    {
+      constexpr rlim_t descriptor_count = 1100;
+      rlimit limit{};
+      ASSERT(!::getrlimit(RLIMIT_NOFILE, &limit));
+      if (limit.rlim_cur < descriptor_count + 16 && limit.rlim_max >= descriptor_count + 16) {
+        limit.rlim_cur = descriptor_count + 16;
+        ASSERT(!::setrlimit(RLIMIT_NOFILE, &limit));
+      }
+
+      if (limit.rlim_cur >= descriptor_count + 16) {
+        std::vector<int> descriptors;
+        for (rlim_t i = 0; i < descriptor_count; ++i) {
+          const int fd = ::open("/dev/null", O_RDONLY);
+          ASSERT(fd >= 0);
+          descriptors.push_back(fd);
+        }
+
+        int pair[2];
+        ASSERT(!::socketpair(AF_UNIX, SOCK_STREAM, 0, pair));
+        ASSERT(pair[0] >= FD_SETSIZE && pair[1] >= FD_SETSIZE);
+
+        using Sr = net::Socket_readiness;
+        ASSERT(net::poll(pair[0], Sr::read_ready, std::chrono::milliseconds{0}) == Sr::unready);
+        ASSERT(net::poll(pair[1], Sr::write_ready, std::chrono::milliseconds{0}) == Sr::write_ready);
+        ASSERT(::write(pair[1], "x", 1) == 1);
+        ASSERT(net::poll(pair[0], Sr::read_ready | Sr::write_ready, std::chrono::milliseconds{-1}) ==
+          (Sr::read_ready | Sr::write_ready));
+
+        ::close(pair[1]);
+        ASSERT(net::poll(pair[0], Sr::read_ready, std::chrono::milliseconds{0}) == Sr::read_ready);
+        ::close(pair[0]);
+        for (const int fd : descriptors)
+          ::close(fd);
+      }
+    }
+#endif
   } catch (const std::exception& e) {
     report_failure(argv[0], e);
     return 1;